@@ -0,0 +1,11 @@
+/*
+	Modern C++ Command Line Arguments Library
+
+	Copyright (c) 2019 Vladislav Kaminsky(wlodzislav@outlook.com)
+
+	MIT License <https://github.com/wlodzislav/args/blob/master/LICENSE>
+*/
+
+#define ARGS_LIBRARY
+#define ARGS_LIBRARY_IMPLEMENTATION
+#include "args.h"
@@ -0,0 +1,77 @@
+/*
+	Modern C++ Command Line Arguments Library
+
+	Copyright (c) 2019 Vladislav Kaminsky(wlodzislav@outlook.com)
+
+	MIT License <https://github.com/wlodzislav/args/blob/master/LICENSE>
+*/
+
+module;
+
+#include <type_traits>
+#include <sstream>
+#include <functional>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <stdexcept>
+#include <iterator>
+#include <optional>
+#include <iostream>
+#include <iomanip>
+#include <ios>
+#include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <string_view>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <span>
+#include <exception>
+#include <charconv>
+#include <system_error>
+#include <memory>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <mutex>
+#include <condition_variable>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+#if __has_include(<sys/socket.h>) && __has_include(<sys/un.h>) && __has_include(<sys/wait.h>) && __has_include(<poll.h>)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <signal.h>
+#include <fcntl.h>
+#endif
+#if __has_include(<unistd.h>) && __has_include(<dirent.h>) && __has_include(<sys/stat.h>)
+#include <dirent.h>
+#include <sys/stat.h>
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#endif
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>)
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+#endif
+
+
+export module args;
+
+#define ARGS_MODULE
+#include "args.h"
@@ -9,13 +9,32 @@
 #ifndef ARGS_H
 #define ARGS_H
 
+#if __has_include(<sys/socket.h>) && __has_include(<sys/un.h>) && __has_include(<sys/wait.h>) && __has_include(<poll.h>)
+#define ARGS_UNIX_SOCKETS
+#endif
+#if __has_include(<unistd.h>) && __has_include(<dirent.h>) && __has_include(<sys/stat.h>)
+#define ARGS_EXTERNAL_COMMANDS
+#endif
+#if defined(ARGS_EXTERNAL_COMMANDS) && __has_include(<dlfcn.h>)
+#define ARGS_PLUGINS
+#endif
+#if defined(ARGS_EXTERNAL_COMMANDS) && __has_include(<sys/mman.h>) && __has_include(<fcntl.h>)
+#define ARGS_MAPPED_FILES
+#define ARGS_RESPONSE_FILES
+#define ARGS_ARGUMENT_STREAMS
+#define ARGS_BINARY_ARRAYS
+#endif
+
+#if !defined(ARGS_IMPORT) || defined(ARGS_MODULE)
 #include <type_traits>
 #include <sstream>
 #include <functional>
 #include <algorithm>
 #include <vector>
+#include <deque>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <stdexcept>
 #include <iterator>
 #include <optional>
@@ -23,30 +42,249 @@
 #include <iomanip>
 #include <ios>
 #include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <string_view>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <span>
+#include <exception>
+#include <charconv>
+#include <system_error>
+#include <memory>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+#ifdef ARGS_UNIX_SOCKETS
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <signal.h>
+#include <fcntl.h>
+#endif
+#ifdef ARGS_EXTERNAL_COMMANDS
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+#ifdef ARGS_PLUGINS
+#include <dlfcn.h>
+#endif
+#ifdef ARGS_MAPPED_FILES
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+#endif
+
+#if defined(__ELF__)
+#define ARGS_FLAG(type, name, ...) \
+	constinit args::flag<type> name{__VA_ARGS__}; \
+	[[gnu::used, gnu::section("args_flags")]] constinit args::flag_base* const name##_args_flag = &name.entry
+#else
+#define ARGS_FLAG(type, name, ...) \
+	constinit args::flag<type> name{__VA_ARGS__}; \
+	static const auto name##_args_flag = (args::flag_registry().push_back(&name.entry), true)
+
+#endif
+
+#define ARGS_PLUGIN(name, alias, description) \
+	extern "C" void args_plugin_info(args::plugin_info& info) { \
+		info = {name, alias, description}; \
+	} \
+	extern "C" void args_plugin_register(args::detail::command_internal& command)
+#if defined(ARGS_IMPORT) && !defined(ARGS_MODULE)
+import args;
+#else
+#ifdef ARGS_MODULE
+#define ARGS_EXPORT export
+#else
+#define ARGS_EXPORT
+#endif
+
+#if defined(ARGS_LIBRARY_IMPLEMENTATION) || defined(ARGS_MODULE)
+#define ARGS_INLINE
+#define ARGS_EXTERN
+#else
+#define ARGS_INLINE inline
+#define ARGS_EXTERN extern
+#endif
+
+#if !defined(ARGS_LIBRARY) || defined(ARGS_LIBRARY_IMPLEMENTATION)
+#define ARGS_HEADER_DEFINITIONS
+#endif
 
 using namespace std::literals;
 
-namespace {
-	bool is_short_option(const std::string& opt) {
+namespace args {
+	namespace detail {}
+	using namespace detail;
+}
+
+ARGS_EXPORT namespace args {
+	enum class errc {
+		none,
+		invalid_option,
+		invalid_option_value,
+		invalid_command_option_value,
+		invalid_arg_value,
+		invalid_command_arg_value,
+		unexpected_arg,
+		missing_command,
+		missing_option,
+		missing_command_option,
+		missing_arg,
+		missing_command_arg,
+		invalid_response_file,
+		recursive_response_file,
+		invalid_args_stream,
+		help_requested
+	};
+
+	enum class value_errc {
+		none,
+		empty,
+		cant_parse,
+		not_flag_value,
+		not_pair,
+		cant_parse_key,
+		cant_parse_pair_value,
+		not_enough_values,
+		invalid_binary_array,
+		handler
+	};
+
+	enum class order {
+		ordered,
+		unordered
+	};
+}
+
+#ifdef ARGS_MAPPED_FILES
+namespace args::detail {
+	class mapped_file {
+		public:
+		std::string_view text = {};
+		std::string buffer = ""s;
+		void* mapping = nullptr;
+		dev_t device = 0;
+		ino_t inode = 0;
+
+		mapped_file() = default;
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file() {
+			if (this->mapping) {
+				::munmap(this->mapping, this->text.size());
+			}
+		}
+	};
+
+	inline std::shared_ptr<const mapped_file> map_file(int fd, bool read_other) {
+		auto file = std::make_shared<mapped_file>();
+		struct stat status;
+		auto ok = ::fstat(fd, &status) == 0;
+		if (ok) {
+			file->device = status.st_dev;
+			file->inode = status.st_ino;
+		}
+		if (ok && S_ISREG(status.st_mode)) {
+			auto size = static_cast<std::size_t>(status.st_size);
+			auto mapping = size > 0 ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+			ok = mapping != MAP_FAILED;
+			if (ok && mapping) {
+				::madvise(mapping, size, MADV_SEQUENTIAL);
+				file->mapping = mapping;
+				file->text = {static_cast<const char*>(mapping), size};
+			}
+		} else if (ok && read_other) {
+			char buffer[65536];
+			auto size = ::read(fd, buffer, sizeof(buffer));
+			for (; size > 0 || (size < 0 && errno == EINTR); size = ::read(fd, buffer, sizeof(buffer))) {
+				file->buffer.append(buffer, size > 0 ? size : 0);
+			}
+			ok = size == 0;
+			file->text = file->buffer;
+		} else {
+			ok = false;
+		}
+		return ok ? file : nullptr;
+	}
+
+	inline std::shared_ptr<const mapped_file> map_file(const std::string& path) {
+		auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return nullptr;
+		}
+		auto file = map_file(fd, true);
+		::close(fd);
+		return file;
+	}
+}
+#endif
+
+#ifdef ARGS_BINARY_ARRAYS
+ARGS_EXPORT namespace args {
+	template<typename T>
+	struct binary_array {
+		std::span<const T> values = {};
+		std::shared_ptr<const void> storage = nullptr;
+	};
+}
+#endif
+
+namespace args::detail {
+	template<typename E>
+	[[noreturn]] void throw_exception(const E& err) {
+#ifdef __cpp_exceptions
+		throw err;
+#else
+		std::cerr << err.what() << std::endl;
+		std::abort();
+#endif
+	}
+
+	inline bool is_short_option(const std::string& opt) {
 		return opt.starts_with('-') && opt != "--" && opt.size() == 2;
 	}
 
-	bool is_long_option(const std::string& opt) {
+	inline bool is_long_option(const std::string& opt) {
 		return opt.starts_with("--") && opt.size() > 2;
 	}
 
-	bool is_non_conventional(const std::string& opt) {
+	inline bool is_non_conventional(const std::string& opt) {
 		return !is_short_option(opt) && !is_long_option(opt) && opt != "--"s;
 	}
 
-	bool is_valid_flag_value(const std::string& value) {
+	inline bool is_assignment(std::string_view arg, std::string_view name) {
+		return !name.empty() && arg.size() > name.size() && arg.starts_with(name) && arg[name.size()] == '=';
+	}
+
+	inline bool is_short_name_of(std::string_view short_name, char c) {
+		return short_name.size() == 2 && short_name[0] == '-' && short_name[1] == c;
+	}
+
+	inline bool is_valid_flag_value(std::string_view value) {
 		return value == "1" || value == "0"
 			|| value == "true" || value == "false"
 			|| value == "yes" || value == "no"
 			|| value == "on" || value == "off";
 	}
 
-	bool is_single_word(const std::string& value) {
+	inline bool is_single_word(const std::string& value) {
 		return value.find(' ') == std::string::npos;
 	}
 
@@ -57,19 +295,61 @@ namespace {
 		struct is_stringstreamable<T, std::void_t<decltype(std::declval<std::istringstream&>() >> std::declval<T&>())>> : std::true_type {};
 
 	template<typename T>
-	std::enable_if_t<is_stringstreamable<T>::value>
-	parse_value(const std::string& value, T* destination) {
+	constexpr bool is_char_type = std::is_same<T, char>::value || std::is_same<T, signed char>::value
+		|| std::is_same<T, unsigned char>::value || std::is_same<T, wchar_t>::value
+		|| std::is_same<T, char8_t>::value || std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value;
+
+	template<typename T>
+	constexpr bool is_from_chars_number = (std::is_integral<T>::value && !std::is_same<T, bool>::value && !is_char_type<T>)
+#ifdef __cpp_lib_to_chars
+		|| std::is_floating_point<T>::value
+#endif
+		;
+
+	inline bool is_number_start(std::string_view value) {
+		auto digits = value.starts_with('-') ? value.substr(1) : value;
+		return !digits.empty() && ((digits[0] >= '0' && digits[0] <= '9') || digits[0] == '.');
+	}
+
+	template<typename T>
+	bool read_value(std::string_view value, T& destination) {
+		if constexpr (std::is_same<T, std::string>::value) {
+			constexpr auto whitespace = " \f\n\r\t\v"sv;
+			auto begin = value.find_first_not_of(whitespace);
+			if (begin == std::string_view::npos) {
+				return false;
+			}
+			auto word = value.substr(begin);
+			destination.assign(word.substr(0, word.find_first_of(whitespace)));
+			return true;
+		} else if constexpr (is_from_chars_number<T>) {
+			if (is_number_start(value)) {
+				auto result = T{};
+				auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), result);
+				if (err == std::errc{} && end == value.data() + value.size()) {
+					destination = result;
+					return true;
+				}
+			}
+		}
+		auto ss = std::stringstream{std::string{value}};
+		ss >> destination;
+		return !ss.fail();
+	}
+
+	template<typename T>
+	std::enable_if_t<is_stringstreamable<T>::value, args::value_errc>
+	parse_value(std::string_view value, T* destination) {
 		if (!value.empty()) {
-			auto ss = std::stringstream{value};
-			ss >> *destination;
-			if (ss.fail()) {
-				throw std::runtime_error("Can't parse \""s + value + "\"."s);
+			if (!read_value(value, *destination)) {
+				return args::value_errc::cant_parse;
 			}
 		}
+		return args::value_errc::none;
 	}
 
 	template<>
-	void parse_value(const std::string& value, bool* destination) {
+	inline args::value_errc parse_value(std::string_view value, bool* destination) {
 		if (!value.empty()) {
 			if (value == "1" || value == "true" ||
 				value == "on" || value == "yes") {
@@ -78,114 +358,558 @@ namespace {
 				value == "off" || value == "no") {
 				*destination = false;
 			} else {
-				throw std::runtime_error("Value \""s
-					+ value
-					+ R"(" is not one of "1", "0", "true", "false", "on", "off", "yes", "no".)");
+				return args::value_errc::not_flag_value;
 			}
 		} else {
 			*destination = true;
 		}
+		return args::value_errc::none;
+	}
+
+#ifdef ARGS_BINARY_ARRAYS
+	inline constexpr auto binary_array_prefix = "@bin:"sv;
+	inline constexpr auto binary_array_magic = "ARGS"sv;
+	inline constexpr auto binary_array_header_size = std::size_t{16};
+
+	template<typename T>
+	constexpr bool is_binary_value = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+
+	template<typename T>
+	constexpr std::string_view binary_type_name() {
+		if constexpr (std::is_floating_point<T>::value) {
+			return sizeof(T) == 4 ? "f32"sv : sizeof(T) == 8 ? "f64"sv : ""sv;
+		} else if constexpr (std::is_signed<T>::value) {
+			switch (sizeof(T)) {
+				case 1: return "i8"sv;
+				case 2: return "i16"sv;
+				case 4: return "i32"sv;
+				case 8: return "i64"sv;
+			}
+		} else {
+			switch (sizeof(T)) {
+				case 1: return "u8"sv;
+				case 2: return "u16"sv;
+				case 4: return "u32"sv;
+				case 8: return "u64"sv;
+			}
+		}
+		return ""sv;
+	}
+
+	inline std::shared_ptr<const mapped_file> map_binary_array(std::string_view value, std::string_view type, std::size_t size, std::size_t& count) {
+		if (!value.starts_with(binary_array_prefix) || type.empty()) {
+			return nullptr;
+		}
+		auto file = map_file(std::string{value.substr(binary_array_prefix.size())});
+		if (!file || file->text.size() < binary_array_header_size) {
+			return nullptr;
+		}
+		auto header = file->text.substr(0, binary_array_header_size);
+		auto header_type = header.substr(binary_array_magic.size(), 4);
+		if (!header.starts_with(binary_array_magic) || header_type.substr(0, header_type.find('\0')) != type) {
+			return nullptr;
+		}
+		auto elements = std::uint64_t{0};
+		for (auto i = 0; i < 8; i++) {
+			elements |= std::uint64_t{static_cast<unsigned char>(header[8 + i])} << (8 * i);
+		}
+		auto data_size = file->text.size() - binary_array_header_size;
+		if (elements > data_size / size || elements * size != data_size) {
+			return nullptr;
+		}
+		count = static_cast<std::size_t>(elements);
+		return file;
+	}
+
+	template<typename T>
+	void copy_binary_values(const char* data, std::size_t count, T* destination) {
+		std::memcpy(destination, data, count * sizeof(T));
+		if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+			auto bytes = reinterpret_cast<unsigned char*>(destination);
+			for (std::size_t i = 0; i < count; i++) {
+				std::reverse(bytes + i * sizeof(T), bytes + (i + 1) * sizeof(T));
+			}
+		}
 	}
 
+	template<typename T, typename A>
+	args::value_errc read_binary_array(std::string_view value, std::vector<T, A>& destination) {
+		auto count = std::size_t{0};
+		auto file = map_binary_array(value, binary_type_name<T>(), sizeof(T), count);
+		if (!file) {
+			return args::value_errc::invalid_binary_array;
+		}
+		auto offset = destination.size();
+		destination.resize(offset + count);
+		copy_binary_values(file->text.data() + binary_array_header_size, count, destination.data() + offset);
+		return args::value_errc::none;
+	}
+
+	template<typename T>
+	args::value_errc parse_value(std::string_view value, args::binary_array<T>* destination) {
+		static_assert(is_binary_value<T>, "Binary arrays hold arithmetic values");
+		auto count = std::size_t{0};
+		auto file = map_binary_array(value, binary_type_name<T>(), sizeof(T), count);
+		if (!file) {
+			return args::value_errc::invalid_binary_array;
+		}
+		auto data = file->text.data() + binary_array_header_size;
+		if constexpr (std::endian::native == std::endian::little) {
+			destination->values = {reinterpret_cast<const T*>(data), count};
+			destination->storage = std::move(file);
+		} else {
+			auto values = std::make_shared<std::vector<T>>(count);
+			copy_binary_values(data, count, values->data());
+			destination->values = *values;
+			destination->storage = std::move(values);
+		}
+		return args::value_errc::none;
+	}
+#endif
+
 	template<typename T>
 	std::enable_if_t<!is_stringstreamable<T>::value
-		&& is_stringstreamable<typename T::value_type>::value
+		&& is_stringstreamable<typename T::value_type>::value,
+		args::value_errc
 	>
-	parse_value(const std::string& value, T* destination) {
+	parse_value(std::string_view value, T* destination) {
+#ifdef ARGS_BINARY_ARRAYS
+		if constexpr (is_binary_value<typename T::value_type>
+				&& std::is_same<T, std::vector<typename T::value_type, typename T::allocator_type>>::value) {
+			if (value.starts_with(binary_array_prefix)) {
+				return read_binary_array(value, *destination);
+			}
+		}
+#endif
 		if (!value.empty()) {
-			auto ss = std::stringstream{value};
 			typename T::value_type c;
-			ss >> c;
-			if (ss.fail()) {
-				throw std::runtime_error("Can't parse \""s + value + "\"."s);
+			if (!read_value(value, c)) {
+				return args::value_errc::cant_parse;
 			}
 			destination->insert(std::end(*destination), c);
 		}
+		return args::value_errc::none;
 	}
 
 	template<typename T>
 	std::enable_if_t<!is_stringstreamable<T>::value
 		&& is_stringstreamable<typename T::key_type>::value
-		&& is_stringstreamable<typename T::mapped_type>::value
+		&& is_stringstreamable<typename T::mapped_type>::value,
+		args::value_errc
 	>
-	parse_value(const std::string& value, T* destination) {
+	parse_value(std::string_view value, T* destination) {
 		auto eq_pos = value.find('=');
-		if (eq_pos == std::string::npos) {
-			throw std::runtime_error("Value \""s + value
-					+ "\" is not key=value pair.");
+		if (eq_pos == std::string_view::npos) {
+			return args::value_errc::not_pair;
 		}
 
-		auto k_str = value.substr(0, eq_pos);
 		typename T::key_type k;
-		auto k_stream = std::stringstream{k_str};
-		k_stream >> k;
-		if (k_stream.fail()) {
-			throw std::runtime_error("Can't parse key in pair \""s + value + "\"."s);
+		if (!read_value(value.substr(0, eq_pos), k)) {
+			return args::value_errc::cant_parse_key;
 		}
 
-		auto v_str = value.substr(eq_pos + 1);
 		typename T::mapped_type v;
-		auto v_stream = std::stringstream{v_str};
-		v_stream >> v;
-		if (v_stream.fail()) {
-			throw std::runtime_error("Can't parse value in pair \""s + value + "\"."s);
+		if (!read_value(value.substr(eq_pos + 1), v)) {
+			return args::value_errc::cant_parse_pair_value;
 		}
 
 		(*destination)[k] = v;
+		return args::value_errc::none;
 	}
 
 	template<typename T>
 	std::enable_if_t<!is_stringstreamable<T>::value
 		&& is_stringstreamable<typename T::first_type>::value
-		&& is_stringstreamable<typename T::second_type>::value
+		&& is_stringstreamable<typename T::second_type>::value,
+		args::value_errc
 	>
-	parse_value(const std::string& value, T* destination) {
+	parse_value(std::string_view value, T* destination) {
 		auto eq_pos = value.find('=');
-		if (eq_pos == std::string::npos) {
-			throw std::runtime_error("Value \""s + value
-					+ "\" is not key=value pair.");
+		if (eq_pos == std::string_view::npos) {
+			return args::value_errc::not_pair;
 		}
 
-		auto k_str = value.substr(0, eq_pos);
 		typename T::first_type k;
-		auto k_stream = std::stringstream{k_str};
-		k_stream >> k;
-		if (k_stream.fail()) {
-			throw std::runtime_error("Can't parse key in pair \""s + value + "\"."s);
+		if (!read_value(value.substr(0, eq_pos), k)) {
+			return args::value_errc::cant_parse_key;
 		}
 
-		auto v_str = value.substr(eq_pos + 1);
 		typename T::second_type v;
-		auto v_stream = std::stringstream{v_str};
-		v_stream >> v;
-		if (v_stream.fail()) {
-			throw std::runtime_error("Can't parse value in pair \""s + value + "\"."s);
+		if (!read_value(value.substr(eq_pos + 1), v)) {
+			return args::value_errc::cant_parse_pair_value;
 		}
 
 		*destination = {k, v};
+		return args::value_errc::none;
 	}
 
-	template <typename T>
-	std::function<void (const std::string&)> create_parse_fun(T* destination) {
-		return [=](const std::string& value) { parse_value(value, destination); };
-	}
+	using parse_fun_t = std::function<args::value_errc (std::string_view, void*)>;
 
 	template <typename T, typename F>
-	std::function<void (const std::string&)> create_parse_fun(F handler) {
-		return [=](const std::string& value) {
+	parse_fun_t create_parse_fun(F handler) {
+		return [=](std::string_view value, void*) {
+			T destination;
+			auto err = parse_value(value, &destination);
+			if (err == args::value_errc::none) {
+				handler(destination);
+			}
+			return err;
+		};
+	}
+
+	using rest_commit_t = std::function<void ()>;
+	using rest_work_t = std::function<rest_commit_t ()>;
+	using rest_prepare_t = std::function<args::value_errc (std::string_view, rest_work_t&)>;
+
+	template<typename T, typename F>
+	rest_prepare_t create_rest_prepare(F handler) {
+		return [=](std::string_view value, rest_work_t& work) {
+			T destination;
+			auto err = parse_value(value, &destination);
+			if (err == args::value_errc::none) {
+				work = [=] {
+					handler(destination);
+					return rest_commit_t{};
+				};
+			}
+			return err;
+		};
+	}
+
+	template<typename T, typename F, typename C>
+	rest_prepare_t create_rest_prepare(F handler, C* results) {
+		return [=](std::string_view value, rest_work_t& work) {
 			T destination;
-			parse_value(value, &destination);
-			handler(destination);
+			auto err = parse_value(value, &destination);
+			if (err == args::value_errc::none) {
+				work = [=] {
+					return rest_commit_t{[=, result = handler(destination)] {
+						results->insert(std::end(*results), result);
+					}};
+				};
+			}
+			return err;
+		};
+	}
+
+	using bulk_fun_t = std::function<args::value_errc (std::span<const std::string_view>, void*, std::size_t&)>;
+
+	template<typename T, typename F>
+	bulk_fun_t create_bulk_fun(F handler) {
+		return [=](std::span<const std::string_view> values, void*, std::size_t& failed) {
+			if constexpr (std::is_same<T, std::string_view>::value) {
+				handler(values);
+			} else {
+				auto converted = std::vector<T>(values.size());
+				for (std::size_t i = 0; i < values.size(); i++) {
+					auto err = parse_value(values[i], &converted[i]);
+					if (err != args::value_errc::none) {
+						failed = i;
+						return err;
+					}
+				}
+				handler(std::span<const T>{converted});
+			}
+			return args::value_errc::none;
 		};
 	}
 
-	auto max_label_width = 16;
-	auto default_indentation = "      "s;
+	template<typename C>
+	args::value_errc insert_values(std::span<const std::string_view> values, C* destination, std::size_t& failed) {
+		auto converted = std::vector<typename C::value_type>(values.size());
+		for (std::size_t i = 0; i < values.size(); i++) {
+			auto err = parse_value(values[i], &converted[i]);
+			if (err != args::value_errc::none) {
+				failed = i;
+				return err;
+			}
+		}
+		auto first = std::make_move_iterator(std::begin(converted));
+		auto last = std::make_move_iterator(std::end(converted));
+		if constexpr (requires { destination->insert(std::end(*destination), first, last); }) {
+			destination->insert(std::end(*destination), first, last);
+		} else {
+			destination->insert(first, last);
+		}
+		return args::value_errc::none;
+	}
+
+	class rest_pool {
+		private:
+		std::mutex mutex;
+		std::condition_variable work_ready;
+		std::condition_variable work_done;
+		std::deque<std::pair<std::size_t, rest_work_t>> queue = {};
+		std::vector<rest_commit_t> commits = {};
+		std::vector<char> finished = {};
+		std::vector<int> tokens = {};
+		std::vector<std::size_t> completed = {};
+		std::size_t next_commit = 0;
+		std::size_t pending = 0;
+		bool ordered = true;
+		bool stopping = false;
+		std::vector<std::thread> workers = {};
+
+		void work() {
+			auto lock = std::unique_lock{this->mutex};
+			while (true) {
+				this->work_ready.wait(lock, [&] {
+					return this->stopping || !this->queue.empty();
+				});
+				if (this->queue.empty()) {
+					return;
+				}
+				auto [index, work] = std::move(this->queue.front());
+				this->queue.pop_front();
+				lock.unlock();
+
+				auto commit = rest_commit_t{};
+#ifdef __cpp_exceptions
+				auto error = std::exception_ptr{};
+				try {
+					commit = work();
+				} catch (...) {
+					error = std::current_exception();
+				}
+#else
+				commit = work();
+#endif
+
+				lock.lock();
+#ifdef __cpp_exceptions
+				if (error && index < this->failure_index) {
+					this->failure = error;
+					this->failure_index = index;
+					this->failure_token = this->tokens[index];
+				}
+#endif
+				this->commits[index] = std::move(commit);
+				this->finished[index] = true;
+				if (!this->ordered) {
+					this->completed.push_back(index);
+				}
+				if (--this->pending == 0) {
+					this->work_done.notify_all();
+				}
+			}
+		}
+
+		public:
+#ifdef __cpp_exceptions
+		std::exception_ptr failure = nullptr;
+#endif
+		std::size_t failure_index = static_cast<std::size_t>(-1);
+		int failure_token = -1;
+		bool active = false;
+
+		rest_pool(std::size_t threads_count) {
+			this->workers.reserve(threads_count);
+			for (std::size_t t = 0; t < threads_count; t++) {
+				this->workers.emplace_back([this] {
+					this->work();
+				});
+			}
+		}
+
+		rest_pool(const rest_pool&) = delete;
+
+		~rest_pool() {
+			{
+				auto lock = std::lock_guard{this->mutex};
+				this->queue.clear();
+				this->stopping = true;
+			}
+			this->work_ready.notify_all();
+			for (auto& worker : this->workers) {
+				worker.join();
+			}
+		}
+
+		std::size_t size() const {
+			return this->workers.size();
+		}
+
+		void start(bool ordered) {
+			this->ordered = ordered;
+			this->active = true;
+		}
+
+		void stop() {
+			{
+				auto lock = std::unique_lock{this->mutex};
+				this->pending -= this->queue.size();
+				this->queue.clear();
+				this->work_done.wait(lock, [&] {
+					return this->pending == 0;
+				});
+				this->commits.clear();
+				this->finished.clear();
+				this->tokens.clear();
+				this->completed.clear();
+				this->next_commit = 0;
+#ifdef __cpp_exceptions
+				this->failure = nullptr;
+#endif
+				this->failure_index = static_cast<std::size_t>(-1);
+				this->failure_token = -1;
+			}
+			this->active = false;
+		}
+
+		void submit(rest_work_t work, int token) {
+			{
+				auto lock = std::lock_guard{this->mutex};
+				auto index = this->commits.size();
+				this->commits.emplace_back();
+				this->finished.push_back(false);
+				this->tokens.push_back(token);
+				this->queue.emplace_back(index, std::move(work));
+				this->pending++;
+			}
+			this->work_ready.notify_one();
+		}
+
+		void commit_ready() {
+			auto ready = std::vector<rest_commit_t>{};
+			{
+				auto lock = std::lock_guard{this->mutex};
+				if (this->ordered) {
+					for (; this->next_commit < this->finished.size() && this->finished[this->next_commit]; this->next_commit++) {
+						ready.push_back(std::move(this->commits[this->next_commit]));
+					}
+				} else {
+					for (auto index : this->completed) {
+						ready.push_back(std::move(this->commits[index]));
+					}
+					this->completed.clear();
+				}
+			}
+			for (auto& commit : ready) {
+				if (commit) {
+					commit();
+				}
+			}
+		}
+
+		void drain() {
+			{
+				auto lock = std::unique_lock{this->mutex};
+				this->work_done.wait(lock, [&] {
+					return this->pending == 0;
+				});
+			}
+			this->commit_ready();
+		}
+	};
+
+	struct rest_pools {
+		std::unique_ptr<rest_pool> global = nullptr;
+		std::unique_ptr<rest_pool> command = nullptr;
+
+		rest_pools() = default;
+
+		rest_pools(const rest_pools&) {}
+
+		rest_pools& operator=(const rest_pools&) {
+			return *this;
+		}
+	};
+
+	class rest_pools_guard {
+		private:
+		rest_pools& pools;
+
+		public:
+		explicit rest_pools_guard(rest_pools& pools)
+			: pools(pools) {}
+
+		rest_pools_guard(const rest_pools_guard&) = delete;
+
+		~rest_pools_guard() {
+			for (auto pool : {this->pools.global.get(), this->pools.command.get()}) {
+				if (pool && pool->active) {
+					pool->stop();
+				}
+			}
+		}
+	};
+
+	inline constexpr auto max_label_width = 16;
+	inline const auto default_indentation = "      "s;
 }
 
-namespace args {
+#ifdef ARGS_BINARY_ARRAYS
+ARGS_EXPORT namespace args {
+	template<typename R>
+	bool write_binary_array(const std::string& path, const R& values) {
+		using T = std::remove_cvref_t<decltype(*std::data(values))>;
+		static_assert(is_binary_value<T>, "Binary arrays hold arithmetic values");
+		auto header = std::string{binary_array_magic};
+		header.append(binary_type_name<T>());
+		header.resize(8, '\0');
+		auto count = static_cast<std::uint64_t>(std::size(values));
+		for (auto i = 0; i < 8; i++) {
+			header.push_back(static_cast<char>(count >> (8 * i)));
+		}
+		auto file = std::fopen(path.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+		auto written = std::fwrite(header.data(), 1, header.size(), file) == header.size();
+		if constexpr (std::endian::native == std::endian::little) {
+			written = written && std::fwrite(std::data(values), sizeof(T), std::size(values), file) == std::size(values);
+		} else {
+			for (auto value : values) {
+				auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+				std::reverse(std::begin(bytes), std::end(bytes));
+				written = written && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+			}
+		}
+		return std::fclose(file) == 0 && written;
+	}
+}
+#endif
+
+ARGS_EXPORT namespace args {
+	template<typename T>
+	parse_fun_t value_parser(T* destination) {
+		return [=](std::string_view value, void*) { return parse_value(value, destination); };
+	}
+
 	class required_t {};
-	const auto required = required_t{};
+	inline const auto required = required_t{};
+
+	struct nargs {
+		std::size_t min = 1;
+		std::size_t max = 1;
+
+		nargs(int count)
+			: min(static_cast<std::size_t>(count)),
+			max(static_cast<std::size_t>(count)) {
+
+				if (count < 0) {
+					throw_exception(std::invalid_argument("Values count should not be negative"));
+				}
+			}
+
+		nargs(char spec)
+			: min(spec == '+' ? 1 : 0),
+			max(spec == '?' ? 1 : std::numeric_limits<std::size_t>::max()) {
+
+				if (spec != '+' && spec != '*' && spec != '?') {
+					throw_exception(std::invalid_argument("Values count should be a number, '+', '*' or '?'"));
+				}
+			}
+
+		nargs(std::size_t min, std::size_t max)
+			: min(min),
+			max(max) {
+
+				if (min > max) {
+					throw_exception(std::invalid_argument("Minimum values count should not exceed maximum"));
+				}
+			}
+	};
 
 	struct option {
 		std::string short_name;
@@ -194,14 +918,16 @@ namespace args {
 		std::string description = ""s;
 		bool required = false;
 		bool is_flag = false;
-		std::function<void (const std::string&)> parse_fun;
-		bool exists = false;
+		parse_fun_t parse_fun;
+		std::size_t min_values = 1;
+		std::size_t max_values = 1;
+		bulk_fun_t bulk_fun = nullptr;
 
 		option(const option&) = default;
 
 		option(const std::string& name, const std::string& short_name, const std::string& long_name_or_desc,
 				const std::string& description,
-				bool required, bool is_flag, std::function<void (const std::string&)> parse_fun)
+				bool required, bool is_flag, parse_fun_t parse_fun)
 			: short_name(is_short_option(name) ? name : short_name),
 			non_conventional(is_non_conventional(name) ? name : ""),
 			required(required),
@@ -223,44 +949,41 @@ namespace args {
 
 		template<typename T>
 		option(const std::string& name, T* destination)
-			: option(name, "", "", "", false, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
+			: option(name, "", "", "", false, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 
 		template<typename T>
 		option(required_t, const std::string& name, T* destination)
-			: option(name, "", "", "", true, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
-
+			: option(name, "", "", "", true, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 
 		template<typename T>
 		option(const std::string& short_name, const std::string& long_name_or_desc, T* destination)
-			: option("", short_name, long_name_or_desc, "", false, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
+			: option("", short_name, long_name_or_desc, "", false, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 
 		template<typename T>
 		option(required_t, const std::string short_name, const std::string& long_name_or_desc, T* destination)
-			: option("", short_name, long_name_or_desc, "", true, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
+			: option("", short_name, long_name_or_desc, "", true, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 
 		template<typename T>
 		option(const std::string& short_name, const std::string& long_name, const std::string& description, T* destination)
-			: option("", short_name, long_name, description, false, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
+			: option("", short_name, long_name, description, false, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 
 		template<typename T>
 		option(required_t, const std::string& short_name, const std::string& long_name, const std::string& description, T* destination)
-			: option("", short_name, long_name, description, true, std::is_same<T, bool>::value, create_parse_fun(destination)) {}
-
-		void parse(const std::string& value) {
-			this->parse_fun(value);
-			this->exists = true;
-		}
+			: option("", short_name, long_name, description, true, std::is_same<T, bool>::value, args::value_parser(destination)) {}
 	};
 }
 
-namespace {
+namespace args::detail {
 	struct arg_internal {
 		public:
 		std::string name = ""s;
 		std::string description = ""s;
 		bool required = false;
-		std::function<void (const std::string&)> parse_fun;
-		bool exists = false;
+		parse_fun_t parse_fun;
+		rest_prepare_t parallel_fun = nullptr;
+		bulk_fun_t bulk_fun = nullptr;
+		std::size_t threads_count = 0;
+		bool ordered = true;
 
 		arg_internal(const arg_internal&) = default;
 		arg_internal() = default;
@@ -292,299 +1015,718 @@ namespace {
 			description(description),
 			required(true),
 			parse_fun(parse) {}
+	};
 
-		void parse(const std::string& value) {
-			this->parse_fun(value);
-			this->exists = true;
-		}
+	template<typename T>
+	inline constexpr char type_tag = 0;
+
+	struct result_slot {
+		std::size_t offset = 0;
+		void (*construct)(void*) = nullptr;
+		void (*copy)(void*, const void*) = nullptr;
+		void (*reset)(void*) = nullptr;
+		void (*destroy)(void*) = nullptr;
 	};
 
-	struct command_internal {
-		std::vector<args::option> options = {};
-		std::vector<arg_internal> args = {};
-		arg_internal rest_args = {};
-		std::function<void ()> action_fun = 0;
-		std::string name;
-		std::string alias = ""s;
-		std::string description = ""s;
-		bool* destination = nullptr;
+	template<typename T>
+	struct result_slot_functions {
+		static void construct(void* slot) {
+			new (slot) T{};
+		}
 
-		command_internal(const command_internal&) = default;
+		static void copy(void* slot, const void* other) {
+			new (slot) T(*static_cast<const T*>(other));
+		}
 
-		command_internal(const std::string& name)
-			: name(name) {}
+		static void reset(void* slot) {
+			if constexpr (requires (T& value) { value.clear(); }) {
+				static_cast<T*>(slot)->clear();
+			} else {
+				*static_cast<T*>(slot) = T{};
+			}
+		}
 
-		command_internal(const std::string& name, bool* destination)
-			: name(name),
-			destination(destination) {}
+		static void destroy(void* slot) {
+			static_cast<T*>(slot)->~T();
+		}
+	};
 
-		command_internal(const std::string& name, const std::string& alias_or_desc)
-			: name(name) {
+	struct result_layout {
+		std::vector<result_slot> slots = {};
+		std::size_t size = 0;
 
-				if (is_single_word(alias_or_desc)) {
-					this->alias = alias_or_desc;
-				} else {
-					this->description = alias_or_desc;
+		template<typename T>
+		std::size_t add() {
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned values are not supported");
+			using functions = result_slot_functions<T>;
+			auto offset = (this->size + alignof(T) - 1) / alignof(T) * alignof(T);
+			this->slots.push_back({offset, &functions::construct, &functions::copy, &functions::reset, &functions::destroy});
+			this->size = offset + sizeof(T);
+			return offset;
+		}
+	};
+
+	template<typename Derived>
+	struct registrar;
+}
+
+ARGS_EXPORT namespace args {
+	template<typename T>
+	class handle {
+		private:
+		template<typename> friend struct detail::registrar;
+		friend class result;
+
+		std::size_t offset = 0;
+
+		public:
+		handle() = default;
+	};
+
+	class result {
+		private:
+		friend class parser;
+
+		std::shared_ptr<const detail::result_layout> layout = nullptr;
+		std::size_t slots_count = 0;
+		std::vector<std::max_align_t> arena = {};
+
+		std::byte* data() {
+			return reinterpret_cast<std::byte*>(this->arena.data());
+		}
+
+		const std::byte* data() const {
+			return reinterpret_cast<const std::byte*>(this->arena.data());
+		}
+
+		void destroy() {
+			for (std::size_t i = 0; i < this->slots_count; i++) {
+				auto& slot = this->layout->slots[i];
+				slot.destroy(this->data() + slot.offset);
+			}
+			this->slots_count = 0;
+		}
+
+		void prepare(const std::shared_ptr<const detail::result_layout>& layout) {
+			if (this->layout == layout && layout && this->slots_count == layout->slots.size()) {
+				for (auto& slot : layout->slots) {
+					slot.reset(this->data() + slot.offset);
 				}
+				return;
+			}
+			this->destroy();
+			this->layout = layout;
+			if (!layout) {
+				return;
 			}
+			this->arena.resize((layout->size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+			for (auto& slot : layout->slots) {
+				slot.construct(this->data() + slot.offset);
+				this->slots_count++;
+			}
+		}
 
-		command_internal(const std::string& name, const std::string& alias, const std::string& description)
-			: name(name),
-			alias(alias),
-			description(description) {}
+		public:
+		result() = default;
 
-		command_internal(const std::string& name, const std::string& alias_or_desc, bool* destination)
-			: name(name),
-			destination(destination) {
+		result(const result& other)
+			: layout(other.layout),
+			arena(other.arena.size()) {
 
-				if (is_single_word(alias_or_desc)) {
-					this->alias = alias_or_desc;
-				} else {
-					this->description = alias_or_desc;
+				for (std::size_t i = 0; i < other.slots_count; i++) {
+					auto& slot = this->layout->slots[i];
+					slot.copy(this->data() + slot.offset, other.data() + slot.offset);
+					this->slots_count++;
 				}
 			}
 
-		command_internal(const std::string& name, const std::string& alias, const std::string& description, bool* destination)
-			: name(name),
-			alias(alias),
-			description(description),
-			destination(destination) {}
+		result(result&& other) noexcept
+			: layout(std::move(other.layout)),
+			slots_count(std::exchange(other.slots_count, 0)),
+			arena(std::move(other.arena)) {}
 
-		template<typename T>
-		command_internal& arg(T* destination) {
-			this->args.emplace_back(create_parse_fun(destination));
+		result& operator=(result other) noexcept {
+			std::swap(this->layout, other.layout);
+			std::swap(this->slots_count, other.slots_count);
+			std::swap(this->arena, other.arena);
 			return *this;
 		}
 
-		template<typename T>
-		command_internal& arg(const std::string& name, T* destination) {
-			this->args.emplace_back(name, create_parse_fun(destination));
-			return *this;
+		~result() {
+			this->destroy();
 		}
 
 		template<typename T>
-		command_internal& arg(const std::string& name, const std::string& description, T* destination) {
-			this->args.emplace_back(name, description, create_parse_fun(destination));
-			return *this;
+		T& operator[](handle<T> h) {
+			return *std::launder(reinterpret_cast<T*>(this->data() + h.offset));
 		}
 
 		template<typename T>
-		command_internal& arg(args::required_t, const std::string& name, T* destination) {
-			this->args.emplace_back(args::required, name, create_parse_fun(destination));
-			return *this;
+		const T& operator[](handle<T> h) const {
+			return *std::launder(reinterpret_cast<const T*>(this->data() + h.offset));
 		}
+	};
+}
 
-		template<typename T>
-		command_internal& arg(args::required_t, const std::string& name, const std::string& description, T* destination) {
-			this->args.emplace_back(args::required, name, description, create_parse_fun(destination));
-			return *this;
+namespace args::detail {
+
+	template<typename Target>
+	struct target_traits {
+		using value_type = std::remove_pointer_t<Target>;
+	};
+
+	template<typename M, typename C>
+	struct target_traits<M C::*> {
+		using value_type = M;
+		using values_type = C;
+	};
+
+	template<typename V>
+	struct target_traits<args::handle<V>*> {
+		using value_type = V;
+		using values_type = args::result;
+	};
+
+	template<typename Target>
+	constexpr bool is_handle_target = false;
+
+	template<typename V>
+	constexpr bool is_handle_target<args::handle<V>*> = true;
+
+	template<typename T, typename Target>
+	constexpr bool is_destination = std::is_void<T>::value || std::is_same<Target, T*>::value
+		|| (std::is_member_object_pointer<Target>::value && std::is_same<typename target_traits<Target>::value_type, T>::value);
+
+	template<typename T, typename Target>
+	using target_value_t = std::conditional_t<is_destination<T, Target>, typename target_traits<Target>::value_type, T>;
+
+	template<typename T, typename Target>
+	constexpr bool is_flag_target = std::is_same<target_value_t<T, Target>, bool>::value;
+
+	template<typename T, typename Target>
+	parse_fun_t target_parser(Target target) {
+		if constexpr (std::is_member_object_pointer<Target>::value && is_destination<T, Target>) {
+			return [=](std::string_view value, void* values) {
+				using values_type = typename target_traits<Target>::values_type;
+				return parse_value(value, &(static_cast<values_type*>(values)->*target));
+			};
+		} else if constexpr (is_destination<T, Target>) {
+			return args::value_parser(target);
+		} else {
+			return create_parse_fun<T>(target);
 		}
+	}
 
-		template<typename T, typename F>
-		command_internal& arg(F handler) {
-			this->args.emplace_back(create_parse_fun<T>(handler));
-			return *this;
+	template<typename Derived>
+	struct registrar {
+		std::vector<args::option> options = {};
+		std::vector<arg_internal> args = {};
+		arg_internal rest_args = {};
+		const void* values_type = nullptr;
+		std::shared_ptr<result_layout> layout = nullptr;
+
+		template<typename T, typename Target>
+		parse_fun_t target_parser(Target target) {
+			if constexpr (std::is_member_object_pointer<Target>::value || is_handle_target<Target>) {
+				auto values_type = &type_tag<typename target_traits<Target>::values_type>;
+				if (this->values_type && this->values_type != values_type) {
+					throw_exception(std::runtime_error("Member targets should belong to one struct"));
+				}
+				this->values_type = values_type;
+			}
+			if constexpr (is_handle_target<Target>) {
+				using value_type = typename target_traits<Target>::value_type;
+				if (!this->layout) {
+					this->layout = std::make_shared<result_layout>();
+				}
+				target->offset = this->layout->template add<value_type>();
+				return [handle = *target](std::string_view value, void* values) {
+					return parse_value(value, &(*static_cast<args::result*>(values))[handle]);
+				};
+			} else {
+				return detail::target_parser<T>(target);
+			}
 		}
 
-		template<typename T, typename F>
-		command_internal& arg(const std::string& name, F handler) {
-			this->args.emplace_back(name, create_parse_fun<T>(handler));
-			return *this;
+		template<typename T, typename Target>
+		bulk_fun_t target_bulk_parser(Target target) {
+			if constexpr (is_handle_target<Target>) {
+				this->template target_parser<T>(target);
+				return [handle = *target](std::span<const std::string_view> values, void* result, std::size_t& failed) {
+					return insert_values(values, &(*static_cast<args::result*>(result))[handle], failed);
+				};
+			} else if constexpr (std::is_member_object_pointer<Target>::value && is_destination<T, Target>) {
+				this->template target_parser<T>(target);
+				return [=](std::span<const std::string_view> values, void* destination, std::size_t& failed) {
+					using values_type = typename target_traits<Target>::values_type;
+					return insert_values(values, &(static_cast<values_type*>(destination)->*target), failed);
+				};
+			} else if constexpr (is_destination<T, Target>) {
+				return [=](std::span<const std::string_view> values, void*, std::size_t& failed) {
+					return insert_values(values, target, failed);
+				};
+			} else {
+				return create_bulk_fun<T>(target);
+			}
 		}
 
-		template<typename T, typename F>
-		command_internal& arg(const std::string& name, const std::string& description, F handler) {
-			this->args.emplace_back(name, description, create_parse_fun<T>(handler));
-			return *this;
+		Derived& add_option(std::string_view name, std::string_view short_name, std::string_view long_name_or_desc,
+				std::string_view description, bool required, bool is_flag, parse_fun_t parse_fun) {
+			this->options.emplace_back(std::string{name}, std::string{short_name}, std::string{long_name_or_desc}, std::string{description},
+					required, is_flag, std::move(parse_fun));
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T, typename F>
-		command_internal& arg(args::required_t, const std::string& name, F handler) {
-			this->args.emplace_back(args::required, name, create_parse_fun<T>(handler));
-			return *this;
+		Derived& add_nargs_option(args::nargs nargs, std::string_view name, std::string_view short_name, std::string_view long_name_or_desc,
+				std::string_view description, bool required, bulk_fun_t bulk) {
+			this->add_option(name, short_name, long_name_or_desc, description, required, false,
+				[bulk, min = nargs.min](std::string_view value, void* values) {
+					if (min > 1) {
+						return args::value_errc::not_enough_values;
+					}
+					auto failed = std::size_t{0};
+					return bulk(std::span<const std::string_view>{&value, 1}, values, failed);
+				});
+			auto& option = this->options.back();
+			option.min_values = nargs.min;
+			option.max_values = nargs.max;
+			option.bulk_fun = std::move(bulk);
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T, typename F>
-		command_internal& arg(args::required_t, const std::string& name, const std::string& description, F handler) {
-			this->args.emplace_back(args::required, name, description, create_parse_fun<T>(handler));
-			return *this;
+		Derived& add_arg(std::string_view name, std::string_view description, bool required, parse_fun_t parse_fun) {
+			auto& arg = this->args.emplace_back(std::string{name}, std::string{description}, std::move(parse_fun));
+			arg.required = required;
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T>
-		command_internal& rest(T* destination) {
-			this->rest_args = {create_parse_fun(destination)};
-			return *this;
+		Derived& add_rest(std::string_view name, std::string_view description, bool required, parse_fun_t parse_fun) {
+			this->rest_args = {std::string{name}, std::string{description}, std::move(parse_fun)};
+			this->rest_args.required = required;
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T>
-		command_internal& rest(const std::string& name, T* destination) {
-			this->rest_args = {name, create_parse_fun(destination)};
-			return *this;
+		Derived& add_parallel_rest(std::string_view name, std::string_view description, bool required, rest_prepare_t prepare,
+				std::size_t threads_count, args::order order) {
+			this->add_rest(name, description, required, [prepare](std::string_view value, void*) {
+				auto work = rest_work_t{};
+				auto err = prepare(value, work);
+				if (err == args::value_errc::none) {
+					if (auto commit = work()) {
+						commit();
+					}
+				}
+				return err;
+			});
+			this->rest_args.parallel_fun = std::move(prepare);
+			this->rest_args.threads_count = std::max<std::size_t>(1, threads_count);
+			this->rest_args.ordered = order == args::order::ordered;
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T>
-		command_internal& rest(const std::string& name, const std::string& description, T* destination) {
-			this->rest_args = {name, description, create_parse_fun(destination)};
-			return *this;
+		Derived& add_bulk_rest(std::string_view name, std::string_view description, bool required, bulk_fun_t bulk) {
+			this->add_rest(name, description, required, [bulk](std::string_view value, void* values) {
+				auto failed = std::size_t{0};
+				return bulk(std::span<const std::string_view>{&value, 1}, values, failed);
+			});
+			this->rest_args.bulk_fun = std::move(bulk);
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T>
-		command_internal& rest(args::required_t, const std::string& name, T* destination) {
-			this->rest_args = {args::required, name, create_parse_fun(destination)};
-			return *this;
+		Derived& option(args::option option) {
+			this->options.push_back(option);
+			return static_cast<Derived&>(*this);
 		}
 
-		template<typename T>
-		command_internal& rest(args::required_t, const std::string& name, const std::string& description, T* destination) {
-			this->rest_args = {args::required, name, description, create_parse_fun(destination)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(std::string_view name, Target target) {
+			return this->add_option(name, "", "", "", false, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& rest(F handler) {
-			this->rest_args = {create_parse_fun<T>(handler)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, std::string_view name, Target target) {
+			return this->add_option(name, "", "", "", true, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& rest(const std::string& name, F handler) {
-			this->rest_args = {name, create_parse_fun<T>(handler)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(std::string_view short_name, std::string_view long_name_or_desc, Target target) {
+			return this->add_option("", short_name, long_name_or_desc, "", false, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& rest(const std::string& name, const std::string& description, F handler) {
-			this->rest_args = {name, description, create_parse_fun<T>(handler)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(std::string_view short_name, std::string_view long_name, std::string_view description, Target target) {
+			return this->add_option("", short_name, long_name, description, false, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& rest(args::required_t, const std::string& name, F handler) {
-			this->rest_args = {args::required, name, create_parse_fun<T>(handler)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, std::string_view short_name, std::string_view long_name_or_desc, Target target) {
+			return this->add_option("", short_name, long_name_or_desc, "", true, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& rest(args::required_t, const std::string& name, const std::string& description, F handler) {
-			this->rest_args = {args::required, name, description, create_parse_fun<T>(handler)};
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, std::string_view short_name, std::string_view long_name, std::string_view description, Target target) {
+			return this->add_option("", short_name, long_name, description, true, is_flag_target<T, Target>, this->template target_parser<T>(target));
 		}
 
-		command_internal& option(args::option option) {
-			this->options.push_back(option);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::nargs nargs, std::string_view name, Target target) {
+			return this->add_nargs_option(nargs, name, "", "", "", false, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(const std::string& name, T* destination) {
-			this->options.emplace_back(name, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::nargs nargs, std::string_view short_name, std::string_view long_name_or_desc, Target target) {
+			return this->add_nargs_option(nargs, "", short_name, long_name_or_desc, "", false, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(args::required_t, const std::string& name, T* destination) {
-			this->options.emplace_back(args::required, name, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::nargs nargs, std::string_view short_name, std::string_view long_name, std::string_view description, Target target) {
+			return this->add_nargs_option(nargs, "", short_name, long_name, description, false, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& option(const std::string& name, F handler) {
-			this->options.emplace_back(name, "", "", "",
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, args::nargs nargs, std::string_view name, Target target) {
+			return this->add_nargs_option(nargs, name, "", "", "", true, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T, typename F>
-		command_internal& option(args::required_t, const std::string& name, F handler) {
-			this->options.emplace_back(name, "", "", "",
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, args::nargs nargs, std::string_view short_name, std::string_view long_name_or_desc, Target target) {
+			return this->add_nargs_option(nargs, "", short_name, long_name_or_desc, "", true, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(const std::string& short_name, const std::string& long_name_or_desc, T* destination) {
-			this->options.emplace_back(short_name, long_name_or_desc, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& option(args::required_t, args::nargs nargs, std::string_view short_name, std::string_view long_name, std::string_view description, Target target) {
+			return this->add_nargs_option(nargs, "", short_name, long_name, description, true, this->template target_bulk_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(const std::string& short_name, const std::string& long_name, const std::string& description, T* destination) {
-			this->options.emplace_back(short_name, long_name, description, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& arg(Target target) {
+			return this->add_arg("", "", false, this->template target_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(args::required_t, const std::string& short_name, const std::string& long_name_or_desc, T* destination) {
-			this->options.emplace_back(args::required, short_name, long_name_or_desc, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& arg(std::string_view name, Target target) {
+			return this->add_arg(name, "", false, this->template target_parser<T>(target));
 		}
 
-		template<typename T>
-		command_internal& option(args::required_t, const std::string& short_name, const std::string& long_name, const std::string& description, T* destination) {
-			this->options.emplace_back(args::required, short_name, long_name, description, destination);
-			return *this;
+		template<typename T = void, typename Target>
+		Derived& arg(std::string_view name, std::string_view description, Target target) {
+			return this->add_arg(name, description, false, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& arg(args::required_t, std::string_view name, Target target) {
+			return this->add_arg(name, "", true, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& arg(args::required_t, std::string_view name, std::string_view description, Target target) {
+			return this->add_arg(name, description, true, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& rest(Target target) {
+			return this->add_rest("", "", false, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& rest(std::string_view name, Target target) {
+			return this->add_rest(name, "", false, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& rest(std::string_view name, std::string_view description, Target target) {
+			return this->add_rest(name, description, false, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& rest(args::required_t, std::string_view name, Target target) {
+			return this->add_rest(name, "", true, this->template target_parser<T>(target));
+		}
+
+		template<typename T = void, typename Target>
+		Derived& rest(args::required_t, std::string_view name, std::string_view description, Target target) {
+			return this->add_rest(name, description, true, this->template target_parser<T>(target));
+		}
+
+		template<typename T = std::string_view, typename F>
+		Derived& rest_bulk(std::string_view name, F handler) {
+			return this->add_bulk_rest(name, "", false, create_bulk_fun<T>(handler));
+		}
+
+		template<typename T = std::string_view, typename F>
+		Derived& rest_bulk(std::string_view name, std::string_view description, F handler) {
+			return this->add_bulk_rest(name, description, false, create_bulk_fun<T>(handler));
+		}
+
+		template<typename T = std::string_view, typename F>
+		Derived& rest_bulk(args::required_t, std::string_view name, F handler) {
+			return this->add_bulk_rest(name, "", true, create_bulk_fun<T>(handler));
+		}
+
+		template<typename T = std::string_view, typename F>
+		Derived& rest_bulk(args::required_t, std::string_view name, std::string_view description, F handler) {
+			return this->add_bulk_rest(name, description, true, create_bulk_fun<T>(handler));
 		}
 
 		template<typename T, typename F>
-		command_internal& option(const std::string& short_name, const std::string& long_name_or_desc, F handler) {
-			this->options.emplace_back("", short_name, long_name_or_desc, "",
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		Derived& rest_parallel(std::string_view name, F handler,
+				std::size_t threads_count = std::thread::hardware_concurrency()) {
+			return this->add_parallel_rest(name, "", false, create_rest_prepare<T>(handler), threads_count, args::order::unordered);
 		}
 
 		template<typename T, typename F>
-		command_internal& option(const std::string& short_name, const std::string& long_name, const std::string& description, F handler) {
-			this->options.emplace_back("", short_name, long_name, description,
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		Derived& rest_parallel(std::string_view name, std::string_view description, F handler,
+				std::size_t threads_count = std::thread::hardware_concurrency()) {
+			return this->add_parallel_rest(name, description, false, create_rest_prepare<T>(handler), threads_count, args::order::unordered);
 		}
 
 		template<typename T, typename F>
-		command_internal& option(args::required_t, const std::string& short_name, const std::string& long_name_or_desc, F handler) {
-			this->options.emplace_back("", short_name, long_name_or_desc, "",
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		Derived& rest_parallel(args::required_t, std::string_view name, F handler,
+				std::size_t threads_count = std::thread::hardware_concurrency()) {
+			return this->add_parallel_rest(name, "", true, create_rest_prepare<T>(handler), threads_count, args::order::unordered);
 		}
 
 		template<typename T, typename F>
-		command_internal& option(args::required_t, const std::string& short_name, const std::string& long_name, const std::string& description, F handler) {
-			this->options.emplace_back("", short_name, long_name, description,
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
+		Derived& rest_parallel(args::required_t, std::string_view name, std::string_view description, F handler,
+				std::size_t threads_count = std::thread::hardware_concurrency()) {
+			return this->add_parallel_rest(name, description, true, create_rest_prepare<T>(handler), threads_count, args::order::unordered);
+		}
+
+		template<typename T, typename F, typename C>
+		Derived& rest_parallel(std::string_view name, F handler, C* results,
+				std::size_t threads_count = std::thread::hardware_concurrency(), args::order order = args::order::ordered) {
+			return this->add_parallel_rest(name, "", false, create_rest_prepare<T>(handler, results), threads_count, order);
 		}
 
+		template<typename T, typename F, typename C>
+		Derived& rest_parallel(std::string_view name, std::string_view description, F handler, C* results,
+				std::size_t threads_count = std::thread::hardware_concurrency(), args::order order = args::order::ordered) {
+			return this->add_parallel_rest(name, description, false, create_rest_prepare<T>(handler, results), threads_count, order);
+		}
+
+		template<typename T, typename F, typename C>
+		Derived& rest_parallel(args::required_t, std::string_view name, F handler, C* results,
+				std::size_t threads_count = std::thread::hardware_concurrency(), args::order order = args::order::ordered) {
+			return this->add_parallel_rest(name, "", true, create_rest_prepare<T>(handler, results), threads_count, order);
+		}
+
+		template<typename T, typename F, typename C>
+		Derived& rest_parallel(args::required_t, std::string_view name, std::string_view description, F handler, C* results,
+				std::size_t threads_count = std::thread::hardware_concurrency(), args::order order = args::order::ordered) {
+			return this->add_parallel_rest(name, description, true, create_rest_prepare<T>(handler, results), threads_count, order);
+		}
+	};
+
+	struct command_builder;
+
+	struct command_internal : registrar<command_internal> {
+		std::function<void ()> action_fun = 0;
+		std::function<void (void*)> values_action_fun = 0;
+		std::string name;
+		std::string alias = ""s;
+		std::string description = ""s;
+		bool* destination = nullptr;
+		std::shared_ptr<command_builder> builder = nullptr;
+
+		command_internal(const command_internal&) = default;
+
+		command_internal(const std::string& name)
+			: name(name) {}
+
+		command_internal(const std::string& name, bool* destination)
+			: name(name),
+			destination(destination) {}
+
+		command_internal(const std::string& name, const std::string& alias_or_desc)
+			: name(name) {
+
+				if (is_single_word(alias_or_desc)) {
+					this->alias = alias_or_desc;
+				} else {
+					this->description = alias_or_desc;
+				}
+			}
+
+		command_internal(const std::string& name, const std::string& alias, const std::string& description)
+			: name(name),
+			alias(alias),
+			description(description) {}
+
+		command_internal(const std::string& name, const std::string& alias_or_desc, bool* destination)
+			: name(name),
+			destination(destination) {
+
+				if (is_single_word(alias_or_desc)) {
+					this->alias = alias_or_desc;
+				} else {
+					this->description = alias_or_desc;
+				}
+			}
+
+		command_internal(const std::string& name, const std::string& alias, const std::string& description, bool* destination)
+			: name(name),
+			alias(alias),
+			description(description),
+			destination(destination) {}
+
 		command_internal& action(std::function<void (void)> action) {
 			this->action_fun = action;
 			return *this;
 		}
+
+		template<typename Values, typename F>
+		command_internal& action(F action) {
+			auto values_type = &type_tag<Values>;
+			if (this->values_type && this->values_type != values_type) {
+				throw_exception(std::runtime_error("Member targets should belong to one struct"));
+			}
+			this->values_type = values_type;
+			this->values_action_fun = [action](void* values) {
+				action(*static_cast<Values*>(values));
+			};
+			return *this;
+		}
+
+		const command_internal& built() const;
 	};
 
-	std::string option_print_name(const args::option& option) {
-		auto name = ""s;
-		auto first = true;
-		if (!option.short_name.empty()) {
-			name += option.short_name;
-			first = false;
+	struct command_builder {
+		std::once_flag once;
+		std::function<void (command_internal&)> build;
+		std::unique_ptr<command_internal> command = nullptr;
+	};
+
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE const command_internal& command_internal::built() const {
+		if (!this->builder) {
+			return *this;
 		}
-		if (!option.long_name.empty()) {
-			if (!first) {
-				name += ", "s;
+		std::call_once(this->builder->once, [this] {
+			auto command = std::make_unique<command_internal>(*this);
+			command->builder = nullptr;
+			command->layout = nullptr;
+			this->builder->build(*command);
+			if (command->layout) {
+				throw_exception(std::runtime_error("Lazy commands can't have handle targets"));
 			}
-			name += option.long_name;
-			first = false;
+			command->layout = this->layout;
+			this->builder->command = std::move(command);
+		});
+		return *this->builder->command;
+	}
+#endif
+
+	struct seen_targets {
+		std::vector<char> options = {};
+		std::vector<char> args = {};
+		char rest = false;
+
+		void reset(std::size_t options_count, std::size_t args_count) {
+			this->options.assign(options_count, false);
+			this->args.assign(args_count, false);
+			this->rest = false;
 		}
-		if (!option.non_conventional.empty()) {
-			if (!first) {
-				name += ", "s;
+	};
+
+	template<typename Targets>
+	auto find_missing(const Targets& targets, const std::vector<char>& seen) {
+		auto target = std::begin(targets);
+		for (auto was_seen : seen) {
+			if (target->required && !was_seen) {
+				return target;
 			}
-			name += option.non_conventional;
+			target++;
 		}
-		return name;
+		return std::end(targets);
 	}
 
-	std::string command_print_name(const command_internal& command, const std::string& delimiter = ", "s) {
-		auto name = ""s;
-		auto first = true;
+	template<typename It>
+	std::size_t command_words(std::string_view name, It word, It end, std::size_t& inspected) {
+		auto words = std::size_t{0};
+		for (; !name.empty(); word++) {
+			inspected = std::max(inspected, words + 1);
+			if (word == end || !name.starts_with(*word)) {
+				return 0;
+			}
+			name.remove_prefix(std::string_view{*word}.size());
+			words++;
+			if (name.empty()) {
+				return words;
+			}
+			if (!name.starts_with(' ')) {
+				return 0;
+			}
+			name.remove_prefix(1);
+		}
+		return 0;
+	}
+
+	inline void write_text(std::string_view text) {
+		std::cout.flush();
+#if __has_include(<unistd.h>)
+		while (!text.empty()) {
+			auto written = ::write(STDOUT_FILENO, text.data(), text.size());
+			if (written < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return;
+			}
+			text.remove_prefix(written);
+		}
+#else
+		std::fwrite(text.data(), 1, text.size(), stdout);
+		std::fflush(stdout);
+#endif
+	}
+
+	template<typename W>
+	constexpr void write_roff(W& w, std::string_view text, bool upper = false) {
+		auto line_start = true;
+		for (auto& c : text) {
+			if (line_start && (c == '.' || c == '\'')) {
+				w("\\&");
+			}
+			line_start = c == '\n';
+			if (c == '\\') {
+				w("\\e");
+			} else if (c == '-') {
+				w("\\-");
+			} else if (upper && c >= 'a' && c <= 'z') {
+				auto u = static_cast<char>(c - 'a' + 'A');
+				w(std::string_view{&u, 1});
+			} else {
+				w(std::string_view{&c, 1});
+			}
+		}
+	}
+
+	inline std::string option_print_name(const args::option& option) {
+		auto name = ""s;
+		auto first = true;
+		if (!option.short_name.empty()) {
+			name += option.short_name;
+			first = false;
+		}
+		if (!option.long_name.empty()) {
+			if (!first) {
+				name += ", "s;
+			}
+			name += option.long_name;
+			first = false;
+		}
+		if (!option.non_conventional.empty()) {
+			if (!first) {
+				name += ", "s;
+			}
+			name += option.non_conventional;
+		}
+		return name;
+	}
+
+	inline std::string command_print_name(const command_internal& command, const std::string& delimiter = ", "s) {
+		auto name = ""s;
+		auto first = true;
 		if (!command.name.empty()) {
 			name += command.name;
 			first = false;
@@ -598,7 +1740,7 @@ namespace {
 		return name;
 	}
 
-	std::string format_usage_options(const std::vector<args::option>& options) {
+	inline std::string format_usage_options(const std::vector<args::option>& options) {
 		auto ss = std::stringstream{};
 		auto has_optional_options = false;
 		std::for_each(std::begin(options), std::end(options), [&](auto& o) {
@@ -622,7 +1764,7 @@ namespace {
 		return ss.str();
 	}
 
-	std::string format_usage_args(const std::vector<arg_internal>& args, const arg_internal& rest_args) {
+	inline std::string format_usage_args(const std::vector<arg_internal>& args, const arg_internal& rest_args) {
 		auto ss = std::stringstream{};
 		std::for_each(std::begin(args), std::end(args), [&](auto& a) {
 			auto arg_name = a.name.empty() ? "ARG" : a.name;
@@ -643,7 +1785,7 @@ namespace {
 		return ss.str();
 	}
 
-	std::string format_options_description(const std::vector<args::option>& options, const std::string& indentation = default_indentation) {
+	inline std::string format_options_description(const std::vector<args::option>& options, const std::string& indentation = default_indentation) {
 		auto ss = std::stringstream{};
 		auto first = true;
 		std::for_each(std::begin(options), std::end(options), [&](auto& o) {
@@ -673,7 +1815,7 @@ namespace {
 		return ss.str();
 	}
 
-	std::string format_args_description(const std::vector<arg_internal>& args, const arg_internal& rest_args, const std::string& indentation) {
+	inline std::string format_args_description(const std::vector<arg_internal>& args, const arg_internal& rest_args, const std::string& indentation) {
 		auto ss = std::stringstream{};
 
 		auto first = true;
@@ -719,9 +1861,117 @@ namespace {
 	}
 }
 
-namespace args {
+ARGS_EXPORT namespace args {
 	using options = std::vector<option>;
 
+	struct error {
+		errc code = errc::none;
+		value_errc reason = value_errc::none;
+		int token = -1;
+		int value_token = -1;
+		std::string_view name = {};
+		std::string_view value = {};
+		std::string_view command = {};
+		std::string_view command_alias = {};
+		const args::option* option = nullptr;
+#ifdef __cpp_exceptions
+		std::exception_ptr cause = nullptr;
+#endif
+
+		explicit operator bool() const {
+			return this->code != errc::none;
+		}
+
+		std::string command_name() const {
+			auto name = std::string{this->command};
+			if (!this->command_alias.empty()) {
+				name += ", "s;
+				name += this->command_alias;
+			}
+			return name;
+		}
+
+		std::string option_name() const {
+			return this->option ? option_print_name(*this->option) : std::string{this->name};
+		}
+
+		std::string reason_message() const {
+			auto value = std::string{this->value};
+			switch (this->reason) {
+				case value_errc::none:
+					return ""s;
+				case value_errc::empty:
+					return "Value is empty."s;
+				case value_errc::cant_parse:
+					return "Can't parse \""s + value + "\"."s;
+				case value_errc::not_flag_value:
+					return "Value \""s + value
+						+ R"(" is not one of "1", "0", "true", "false", "on", "off", "yes", "no".)";
+				case value_errc::not_pair:
+					return "Value \""s + value + "\" is not key=value pair.";
+				case value_errc::cant_parse_key:
+					return "Can't parse key in pair \""s + value + "\"."s;
+				case value_errc::cant_parse_pair_value:
+					return "Can't parse value in pair \""s + value + "\"."s;
+				case value_errc::not_enough_values:
+					return "Not enough values."s;
+				case value_errc::invalid_binary_array:
+					return "Can't read binary array \""s + value + "\"."s;
+				case value_errc::handler:
+#ifdef __cpp_exceptions
+					try {
+						std::rethrow_exception(this->cause);
+					} catch (const std::exception& err) {
+						return err.what();
+					} catch (...) {
+						return "Handler failed."s;
+					}
+#endif
+					return ""s;
+			}
+			return ""s;
+		}
+
+		std::string message() const {
+			auto name = this->option_name();
+			switch (this->code) {
+				case errc::none:
+					return ""s;
+				case errc::invalid_option:
+					return "Invalid option \""s + name + "\".";
+				case errc::invalid_option_value:
+					return "Invalid value for option \""s + name + "\". " + this->reason_message();
+				case errc::invalid_command_option_value:
+					return "Invalid value for command \""s + this->command_name() + "\" option \""s + name + "\". " + this->reason_message();
+				case errc::invalid_arg_value:
+					return "Invalid value for argument \""s + name + "\". " + this->reason_message();
+				case errc::invalid_command_arg_value:
+					return "Invalid value for command \""s + this->command_name() + "\" argument  \""s + name + "\". " + this->reason_message();
+				case errc::unexpected_arg:
+					return "Unexpected argument \""s + std::string{this->value} + "\"."s;
+				case errc::missing_command:
+					return "Command is required."s;
+				case errc::missing_option:
+					return "Option \""s + name + "\" is required.";
+				case errc::missing_command_option:
+					return "Command \""s + this->command_name() + "\" option \""s + name + "\" is required.";
+				case errc::missing_arg:
+					return "Argument \""s + name + "\" is required.";
+				case errc::missing_command_arg:
+					return "Command \""s + this->command_name() + "\" argument \""s + name + "\" is required.";
+				case errc::invalid_response_file:
+					return "Can't read response file \""s + std::string{this->value.substr(1)} + "\"."s;
+				case errc::recursive_response_file:
+					return "Response file \""s + std::string{this->value.substr(1)} + "\" includes itself."s;
+				case errc::invalid_args_stream:
+					return "Can't read arguments from \""s + std::string{this->value} + "\"."s;
+				case errc::help_requested:
+					return "Help requested."s;
+			}
+			return ""s;
+		}
+	};
+
 	class invalid_option : public std::runtime_error {
 		public:
 		const std::string option;
@@ -745,7 +1995,7 @@ namespace args {
 
 	class invalid_command_option_value : public invalid_option_value {
 		public:
-		const std::string& command;
+		const std::string command;
 
 		invalid_command_option_value(const std::string& command, const std::string& option, const std::string& value, const std::string& value_what)
 			: invalid_option_value(option, value, "", "Invalid value for command \""s + command + "\" option \""s + option + "\". " + value_what),
@@ -822,746 +2072,4082 @@ namespace args {
 			: missing_arg(arg, "Command \""s + command + "\" argument \""s + arg + "\" is required."),
 			command(command) {}
 	};
+}
 
-	class parser {
-		private:
+ARGS_EXPORT namespace args {
+	struct field {
+		std::string_view name = {};
+		std::string_view long_name_or_desc = {};
+		std::string_view description = {};
+		bool required = false;
 
-		std::string cmd_name = "";
-		std::string cmd_description = "";
-		bool command_required_f = false;
-		std::vector<option> options = {};
-		std::vector<arg_internal> args = {};
-		arg_internal rest_args = {};
-		std::vector<command_internal> commands = {};
-		std::function<void ()> help_fun;
+		constexpr field(std::string_view name, std::string_view long_name_or_desc = {}, std::string_view description = {})
+			: name(name),
+			long_name_or_desc(long_name_or_desc),
+			description(description) {}
 
-		std::string format_command_usage(const command_internal& c, const std::string& indentation = default_indentation) {
-			auto ss = std::stringstream{};
-			auto names = std::vector<std::string>{c.name};
-			if (!c.alias.empty()) {
-				names.push_back(c.alias);
-			}
+		constexpr field(required_t, std::string_view name, std::string_view long_name_or_desc = {}, std::string_view description = {})
+			: name(name),
+			long_name_or_desc(long_name_or_desc),
+			description(description),
+			required(true) {}
+	};
+}
 
-			auto cmd_name = this->cmd_name.empty() ? "CMD" : this->cmd_name;
-			auto first = true;
-			std::for_each(std::begin(names), std::end(names), [&](auto& name) {
-				if (!first) {
-					ss << "\n";
-				}
-				first = false;
-				ss << indentation << cmd_name;
-				ss << format_usage_options(this->options);
-				ss << format_usage_args(this->args, this->rest_args);
-				ss << " " << name;
-				ss << format_usage_options(c.options);
-				ss << format_usage_args(c.args, c.rest_args);
-			});
-			ss << "\n";
-			return ss.str();
+namespace args::detail {
+	struct any_field {
+		template<typename T>
+		constexpr operator T&() const&& noexcept;
+	};
+
+	template<typename T, std::size_t... I>
+	constexpr bool is_initializable_with(std::index_sequence<I...>) {
+		return requires { T{(I, any_field{})...}; };
+	}
+
+	inline constexpr std::size_t max_bind_fields = 200;
+
+	template<typename T, std::size_t N = 0>
+	constexpr std::size_t field_count() {
+		if constexpr (N >= max_bind_fields || !is_initializable_with<T>(std::make_index_sequence<N + 1>{})) {
+			return N;
+		} else {
+			return field_count<T, N + 1>();
 		}
+	}
 
-		std::string format_command_help(const command_internal& c, const std::string& indentation = default_indentation) {
-			auto ss = std::stringstream{};
-			ss << "USAGE\n";
-			ss << format_command_usage(c, indentation);
+#define ARGS_DROP_FIRST(first, ...) __VA_ARGS__
+#define ARGS_FIELDS(...) ARGS_DROP_FIRST(__VA_ARGS__)
+#define ARGS_FIELDS_PART_0(d)
+#define ARGS_FIELDS_PART_1(d) , f##d##0
+#define ARGS_FIELDS_PART_2(d) , f##d##0, f##d##1
+#define ARGS_FIELDS_PART_3(d) , f##d##0, f##d##1, f##d##2
+#define ARGS_FIELDS_PART_4(d) , f##d##0, f##d##1, f##d##2, f##d##3
+#define ARGS_FIELDS_PART_5(d) , f##d##0, f##d##1, f##d##2, f##d##3, f##d##4
+#define ARGS_FIELDS_PART_6(d) , f##d##0, f##d##1, f##d##2, f##d##3, f##d##4, f##d##5
+#define ARGS_FIELDS_PART_7(d) , f##d##0, f##d##1, f##d##2, f##d##3, f##d##4, f##d##5, f##d##6
+#define ARGS_FIELDS_PART_8(d) , f##d##0, f##d##1, f##d##2, f##d##3, f##d##4, f##d##5, f##d##6, f##d##7
+#define ARGS_FIELDS_PART_9(d) , f##d##0, f##d##1, f##d##2, f##d##3, f##d##4, f##d##5, f##d##6, f##d##7, f##d##8
+#define ARGS_FIELDS_DECADE(d) ARGS_FIELDS_PART_9(d), f##d##9
+#define ARGS_FIELDS_DECADES_0
+#define ARGS_FIELDS_DECADES_1 ARGS_FIELDS_DECADES_0 ARGS_FIELDS_DECADE(0)
+#define ARGS_FIELDS_DECADES_2 ARGS_FIELDS_DECADES_1 ARGS_FIELDS_DECADE(1)
+#define ARGS_FIELDS_DECADES_3 ARGS_FIELDS_DECADES_2 ARGS_FIELDS_DECADE(2)
+#define ARGS_FIELDS_DECADES_4 ARGS_FIELDS_DECADES_3 ARGS_FIELDS_DECADE(3)
+#define ARGS_FIELDS_DECADES_5 ARGS_FIELDS_DECADES_4 ARGS_FIELDS_DECADE(4)
+#define ARGS_FIELDS_DECADES_6 ARGS_FIELDS_DECADES_5 ARGS_FIELDS_DECADE(5)
+#define ARGS_FIELDS_DECADES_7 ARGS_FIELDS_DECADES_6 ARGS_FIELDS_DECADE(6)
+#define ARGS_FIELDS_DECADES_8 ARGS_FIELDS_DECADES_7 ARGS_FIELDS_DECADE(7)
+#define ARGS_FIELDS_DECADES_9 ARGS_FIELDS_DECADES_8 ARGS_FIELDS_DECADE(8)
+#define ARGS_FIELDS_DECADES_10 ARGS_FIELDS_DECADES_9 ARGS_FIELDS_DECADE(9)
+#define ARGS_FIELDS_DECADES_11 ARGS_FIELDS_DECADES_10 ARGS_FIELDS_DECADE(10)
+#define ARGS_FIELDS_DECADES_12 ARGS_FIELDS_DECADES_11 ARGS_FIELDS_DECADE(11)
+#define ARGS_FIELDS_DECADES_13 ARGS_FIELDS_DECADES_12 ARGS_FIELDS_DECADE(12)
+#define ARGS_FIELDS_DECADES_14 ARGS_FIELDS_DECADES_13 ARGS_FIELDS_DECADE(13)
+#define ARGS_FIELDS_DECADES_15 ARGS_FIELDS_DECADES_14 ARGS_FIELDS_DECADE(14)
+#define ARGS_FIELDS_DECADES_16 ARGS_FIELDS_DECADES_15 ARGS_FIELDS_DECADE(15)
+#define ARGS_FIELDS_DECADES_17 ARGS_FIELDS_DECADES_16 ARGS_FIELDS_DECADE(16)
+#define ARGS_FIELDS_DECADES_18 ARGS_FIELDS_DECADES_17 ARGS_FIELDS_DECADE(17)
+#define ARGS_FIELDS_DECADES_19 ARGS_FIELDS_DECADES_18 ARGS_FIELDS_DECADE(18)
+#define ARGS_FIELDS_DECADES_20 ARGS_FIELDS_DECADES_19 ARGS_FIELDS_DECADE(19)
+#define ARGS_TIE_FIELDS(n, ...) \
+		} else if constexpr (N == n) { \
+			auto& [__VA_ARGS__] = value; \
+			return std::tie(__VA_ARGS__);
 
-			if (!c.description.empty()) {
-				ss << "\nDESCRIPTION\n";
-				ss << indentation << c.description << "\n";
-			}
+	template<typename T>
+	auto tie_fields(T& value) {
+		constexpr auto N = field_count<T>();
+		if constexpr (N == 0) {
+			return std::tie();
+		ARGS_TIE_FIELDS(1, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_1(0)))
+		ARGS_TIE_FIELDS(2, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_2(0)))
+		ARGS_TIE_FIELDS(3, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_3(0)))
+		ARGS_TIE_FIELDS(4, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_4(0)))
+		ARGS_TIE_FIELDS(5, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_5(0)))
+		ARGS_TIE_FIELDS(6, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_6(0)))
+		ARGS_TIE_FIELDS(7, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_7(0)))
+		ARGS_TIE_FIELDS(8, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_8(0)))
+		ARGS_TIE_FIELDS(9, ARGS_FIELDS(ARGS_FIELDS_DECADES_0 ARGS_FIELDS_PART_9(0)))
+		ARGS_TIE_FIELDS(10, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_0(1)))
+		ARGS_TIE_FIELDS(11, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_1(1)))
+		ARGS_TIE_FIELDS(12, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_2(1)))
+		ARGS_TIE_FIELDS(13, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_3(1)))
+		ARGS_TIE_FIELDS(14, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_4(1)))
+		ARGS_TIE_FIELDS(15, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_5(1)))
+		ARGS_TIE_FIELDS(16, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_6(1)))
+		ARGS_TIE_FIELDS(17, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_7(1)))
+		ARGS_TIE_FIELDS(18, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_8(1)))
+		ARGS_TIE_FIELDS(19, ARGS_FIELDS(ARGS_FIELDS_DECADES_1 ARGS_FIELDS_PART_9(1)))
+		ARGS_TIE_FIELDS(20, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_0(2)))
+		ARGS_TIE_FIELDS(21, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_1(2)))
+		ARGS_TIE_FIELDS(22, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_2(2)))
+		ARGS_TIE_FIELDS(23, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_3(2)))
+		ARGS_TIE_FIELDS(24, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_4(2)))
+		ARGS_TIE_FIELDS(25, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_5(2)))
+		ARGS_TIE_FIELDS(26, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_6(2)))
+		ARGS_TIE_FIELDS(27, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_7(2)))
+		ARGS_TIE_FIELDS(28, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_8(2)))
+		ARGS_TIE_FIELDS(29, ARGS_FIELDS(ARGS_FIELDS_DECADES_2 ARGS_FIELDS_PART_9(2)))
+		ARGS_TIE_FIELDS(30, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_0(3)))
+		ARGS_TIE_FIELDS(31, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_1(3)))
+		ARGS_TIE_FIELDS(32, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_2(3)))
+		ARGS_TIE_FIELDS(33, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_3(3)))
+		ARGS_TIE_FIELDS(34, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_4(3)))
+		ARGS_TIE_FIELDS(35, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_5(3)))
+		ARGS_TIE_FIELDS(36, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_6(3)))
+		ARGS_TIE_FIELDS(37, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_7(3)))
+		ARGS_TIE_FIELDS(38, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_8(3)))
+		ARGS_TIE_FIELDS(39, ARGS_FIELDS(ARGS_FIELDS_DECADES_3 ARGS_FIELDS_PART_9(3)))
+		ARGS_TIE_FIELDS(40, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_0(4)))
+		ARGS_TIE_FIELDS(41, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_1(4)))
+		ARGS_TIE_FIELDS(42, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_2(4)))
+		ARGS_TIE_FIELDS(43, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_3(4)))
+		ARGS_TIE_FIELDS(44, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_4(4)))
+		ARGS_TIE_FIELDS(45, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_5(4)))
+		ARGS_TIE_FIELDS(46, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_6(4)))
+		ARGS_TIE_FIELDS(47, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_7(4)))
+		ARGS_TIE_FIELDS(48, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_8(4)))
+		ARGS_TIE_FIELDS(49, ARGS_FIELDS(ARGS_FIELDS_DECADES_4 ARGS_FIELDS_PART_9(4)))
+		ARGS_TIE_FIELDS(50, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_0(5)))
+		ARGS_TIE_FIELDS(51, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_1(5)))
+		ARGS_TIE_FIELDS(52, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_2(5)))
+		ARGS_TIE_FIELDS(53, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_3(5)))
+		ARGS_TIE_FIELDS(54, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_4(5)))
+		ARGS_TIE_FIELDS(55, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_5(5)))
+		ARGS_TIE_FIELDS(56, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_6(5)))
+		ARGS_TIE_FIELDS(57, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_7(5)))
+		ARGS_TIE_FIELDS(58, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_8(5)))
+		ARGS_TIE_FIELDS(59, ARGS_FIELDS(ARGS_FIELDS_DECADES_5 ARGS_FIELDS_PART_9(5)))
+		ARGS_TIE_FIELDS(60, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_0(6)))
+		ARGS_TIE_FIELDS(61, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_1(6)))
+		ARGS_TIE_FIELDS(62, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_2(6)))
+		ARGS_TIE_FIELDS(63, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_3(6)))
+		ARGS_TIE_FIELDS(64, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_4(6)))
+		ARGS_TIE_FIELDS(65, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_5(6)))
+		ARGS_TIE_FIELDS(66, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_6(6)))
+		ARGS_TIE_FIELDS(67, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_7(6)))
+		ARGS_TIE_FIELDS(68, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_8(6)))
+		ARGS_TIE_FIELDS(69, ARGS_FIELDS(ARGS_FIELDS_DECADES_6 ARGS_FIELDS_PART_9(6)))
+		ARGS_TIE_FIELDS(70, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_0(7)))
+		ARGS_TIE_FIELDS(71, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_1(7)))
+		ARGS_TIE_FIELDS(72, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_2(7)))
+		ARGS_TIE_FIELDS(73, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_3(7)))
+		ARGS_TIE_FIELDS(74, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_4(7)))
+		ARGS_TIE_FIELDS(75, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_5(7)))
+		ARGS_TIE_FIELDS(76, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_6(7)))
+		ARGS_TIE_FIELDS(77, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_7(7)))
+		ARGS_TIE_FIELDS(78, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_8(7)))
+		ARGS_TIE_FIELDS(79, ARGS_FIELDS(ARGS_FIELDS_DECADES_7 ARGS_FIELDS_PART_9(7)))
+		ARGS_TIE_FIELDS(80, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_0(8)))
+		ARGS_TIE_FIELDS(81, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_1(8)))
+		ARGS_TIE_FIELDS(82, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_2(8)))
+		ARGS_TIE_FIELDS(83, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_3(8)))
+		ARGS_TIE_FIELDS(84, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_4(8)))
+		ARGS_TIE_FIELDS(85, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_5(8)))
+		ARGS_TIE_FIELDS(86, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_6(8)))
+		ARGS_TIE_FIELDS(87, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_7(8)))
+		ARGS_TIE_FIELDS(88, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_8(8)))
+		ARGS_TIE_FIELDS(89, ARGS_FIELDS(ARGS_FIELDS_DECADES_8 ARGS_FIELDS_PART_9(8)))
+		ARGS_TIE_FIELDS(90, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_0(9)))
+		ARGS_TIE_FIELDS(91, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_1(9)))
+		ARGS_TIE_FIELDS(92, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_2(9)))
+		ARGS_TIE_FIELDS(93, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_3(9)))
+		ARGS_TIE_FIELDS(94, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_4(9)))
+		ARGS_TIE_FIELDS(95, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_5(9)))
+		ARGS_TIE_FIELDS(96, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_6(9)))
+		ARGS_TIE_FIELDS(97, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_7(9)))
+		ARGS_TIE_FIELDS(98, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_8(9)))
+		ARGS_TIE_FIELDS(99, ARGS_FIELDS(ARGS_FIELDS_DECADES_9 ARGS_FIELDS_PART_9(9)))
+		ARGS_TIE_FIELDS(100, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_0(10)))
+		ARGS_TIE_FIELDS(101, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_1(10)))
+		ARGS_TIE_FIELDS(102, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_2(10)))
+		ARGS_TIE_FIELDS(103, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_3(10)))
+		ARGS_TIE_FIELDS(104, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_4(10)))
+		ARGS_TIE_FIELDS(105, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_5(10)))
+		ARGS_TIE_FIELDS(106, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_6(10)))
+		ARGS_TIE_FIELDS(107, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_7(10)))
+		ARGS_TIE_FIELDS(108, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_8(10)))
+		ARGS_TIE_FIELDS(109, ARGS_FIELDS(ARGS_FIELDS_DECADES_10 ARGS_FIELDS_PART_9(10)))
+		ARGS_TIE_FIELDS(110, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_0(11)))
+		ARGS_TIE_FIELDS(111, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_1(11)))
+		ARGS_TIE_FIELDS(112, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_2(11)))
+		ARGS_TIE_FIELDS(113, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_3(11)))
+		ARGS_TIE_FIELDS(114, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_4(11)))
+		ARGS_TIE_FIELDS(115, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_5(11)))
+		ARGS_TIE_FIELDS(116, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_6(11)))
+		ARGS_TIE_FIELDS(117, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_7(11)))
+		ARGS_TIE_FIELDS(118, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_8(11)))
+		ARGS_TIE_FIELDS(119, ARGS_FIELDS(ARGS_FIELDS_DECADES_11 ARGS_FIELDS_PART_9(11)))
+		ARGS_TIE_FIELDS(120, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_0(12)))
+		ARGS_TIE_FIELDS(121, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_1(12)))
+		ARGS_TIE_FIELDS(122, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_2(12)))
+		ARGS_TIE_FIELDS(123, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_3(12)))
+		ARGS_TIE_FIELDS(124, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_4(12)))
+		ARGS_TIE_FIELDS(125, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_5(12)))
+		ARGS_TIE_FIELDS(126, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_6(12)))
+		ARGS_TIE_FIELDS(127, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_7(12)))
+		ARGS_TIE_FIELDS(128, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_8(12)))
+		ARGS_TIE_FIELDS(129, ARGS_FIELDS(ARGS_FIELDS_DECADES_12 ARGS_FIELDS_PART_9(12)))
+		ARGS_TIE_FIELDS(130, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_0(13)))
+		ARGS_TIE_FIELDS(131, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_1(13)))
+		ARGS_TIE_FIELDS(132, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_2(13)))
+		ARGS_TIE_FIELDS(133, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_3(13)))
+		ARGS_TIE_FIELDS(134, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_4(13)))
+		ARGS_TIE_FIELDS(135, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_5(13)))
+		ARGS_TIE_FIELDS(136, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_6(13)))
+		ARGS_TIE_FIELDS(137, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_7(13)))
+		ARGS_TIE_FIELDS(138, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_8(13)))
+		ARGS_TIE_FIELDS(139, ARGS_FIELDS(ARGS_FIELDS_DECADES_13 ARGS_FIELDS_PART_9(13)))
+		ARGS_TIE_FIELDS(140, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_0(14)))
+		ARGS_TIE_FIELDS(141, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_1(14)))
+		ARGS_TIE_FIELDS(142, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_2(14)))
+		ARGS_TIE_FIELDS(143, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_3(14)))
+		ARGS_TIE_FIELDS(144, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_4(14)))
+		ARGS_TIE_FIELDS(145, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_5(14)))
+		ARGS_TIE_FIELDS(146, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_6(14)))
+		ARGS_TIE_FIELDS(147, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_7(14)))
+		ARGS_TIE_FIELDS(148, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_8(14)))
+		ARGS_TIE_FIELDS(149, ARGS_FIELDS(ARGS_FIELDS_DECADES_14 ARGS_FIELDS_PART_9(14)))
+		ARGS_TIE_FIELDS(150, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_0(15)))
+		ARGS_TIE_FIELDS(151, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_1(15)))
+		ARGS_TIE_FIELDS(152, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_2(15)))
+		ARGS_TIE_FIELDS(153, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_3(15)))
+		ARGS_TIE_FIELDS(154, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_4(15)))
+		ARGS_TIE_FIELDS(155, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_5(15)))
+		ARGS_TIE_FIELDS(156, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_6(15)))
+		ARGS_TIE_FIELDS(157, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_7(15)))
+		ARGS_TIE_FIELDS(158, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_8(15)))
+		ARGS_TIE_FIELDS(159, ARGS_FIELDS(ARGS_FIELDS_DECADES_15 ARGS_FIELDS_PART_9(15)))
+		ARGS_TIE_FIELDS(160, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_0(16)))
+		ARGS_TIE_FIELDS(161, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_1(16)))
+		ARGS_TIE_FIELDS(162, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_2(16)))
+		ARGS_TIE_FIELDS(163, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_3(16)))
+		ARGS_TIE_FIELDS(164, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_4(16)))
+		ARGS_TIE_FIELDS(165, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_5(16)))
+		ARGS_TIE_FIELDS(166, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_6(16)))
+		ARGS_TIE_FIELDS(167, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_7(16)))
+		ARGS_TIE_FIELDS(168, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_8(16)))
+		ARGS_TIE_FIELDS(169, ARGS_FIELDS(ARGS_FIELDS_DECADES_16 ARGS_FIELDS_PART_9(16)))
+		ARGS_TIE_FIELDS(170, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_0(17)))
+		ARGS_TIE_FIELDS(171, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_1(17)))
+		ARGS_TIE_FIELDS(172, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_2(17)))
+		ARGS_TIE_FIELDS(173, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_3(17)))
+		ARGS_TIE_FIELDS(174, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_4(17)))
+		ARGS_TIE_FIELDS(175, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_5(17)))
+		ARGS_TIE_FIELDS(176, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_6(17)))
+		ARGS_TIE_FIELDS(177, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_7(17)))
+		ARGS_TIE_FIELDS(178, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_8(17)))
+		ARGS_TIE_FIELDS(179, ARGS_FIELDS(ARGS_FIELDS_DECADES_17 ARGS_FIELDS_PART_9(17)))
+		ARGS_TIE_FIELDS(180, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_0(18)))
+		ARGS_TIE_FIELDS(181, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_1(18)))
+		ARGS_TIE_FIELDS(182, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_2(18)))
+		ARGS_TIE_FIELDS(183, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_3(18)))
+		ARGS_TIE_FIELDS(184, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_4(18)))
+		ARGS_TIE_FIELDS(185, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_5(18)))
+		ARGS_TIE_FIELDS(186, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_6(18)))
+		ARGS_TIE_FIELDS(187, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_7(18)))
+		ARGS_TIE_FIELDS(188, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_8(18)))
+		ARGS_TIE_FIELDS(189, ARGS_FIELDS(ARGS_FIELDS_DECADES_18 ARGS_FIELDS_PART_9(18)))
+		ARGS_TIE_FIELDS(190, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_0(19)))
+		ARGS_TIE_FIELDS(191, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_1(19)))
+		ARGS_TIE_FIELDS(192, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_2(19)))
+		ARGS_TIE_FIELDS(193, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_3(19)))
+		ARGS_TIE_FIELDS(194, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_4(19)))
+		ARGS_TIE_FIELDS(195, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_5(19)))
+		ARGS_TIE_FIELDS(196, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_6(19)))
+		ARGS_TIE_FIELDS(197, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_7(19)))
+		ARGS_TIE_FIELDS(198, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_8(19)))
+		ARGS_TIE_FIELDS(199, ARGS_FIELDS(ARGS_FIELDS_DECADES_19 ARGS_FIELDS_PART_9(19)))
+		ARGS_TIE_FIELDS(200, ARGS_FIELDS(ARGS_FIELDS_DECADES_20 ARGS_FIELDS_PART_0(20)))
+		}
+	}
 
-			if (c.args.size() > 0 || c.rest_args.parse_fun) {
-				ss << "\nARGUMENTS\n";
-				ss << format_args_description(c.args, c.rest_args, indentation);
-			}
+#undef ARGS_TIE_FIELDS
+#undef ARGS_FIELDS_DECADES_0
+#undef ARGS_FIELDS_DECADES_1
+#undef ARGS_FIELDS_DECADES_2
+#undef ARGS_FIELDS_DECADES_3
+#undef ARGS_FIELDS_DECADES_4
+#undef ARGS_FIELDS_DECADES_5
+#undef ARGS_FIELDS_DECADES_6
+#undef ARGS_FIELDS_DECADES_7
+#undef ARGS_FIELDS_DECADES_8
+#undef ARGS_FIELDS_DECADES_9
+#undef ARGS_FIELDS_DECADES_10
+#undef ARGS_FIELDS_DECADES_11
+#undef ARGS_FIELDS_DECADES_12
+#undef ARGS_FIELDS_DECADES_13
+#undef ARGS_FIELDS_DECADES_14
+#undef ARGS_FIELDS_DECADES_15
+#undef ARGS_FIELDS_DECADES_16
+#undef ARGS_FIELDS_DECADES_17
+#undef ARGS_FIELDS_DECADES_18
+#undef ARGS_FIELDS_DECADES_19
+#undef ARGS_FIELDS_DECADES_20
+#undef ARGS_FIELDS_DECADE
+#undef ARGS_FIELDS_PART_0
+#undef ARGS_FIELDS_PART_1
+#undef ARGS_FIELDS_PART_2
+#undef ARGS_FIELDS_PART_3
+#undef ARGS_FIELDS_PART_4
+#undef ARGS_FIELDS_PART_5
+#undef ARGS_FIELDS_PART_6
+#undef ARGS_FIELDS_PART_7
+#undef ARGS_FIELDS_PART_8
+#undef ARGS_FIELDS_PART_9
+#undef ARGS_FIELDS
+#undef ARGS_DROP_FIRST
+}
 
-			if (c.options.size() > 0) {
-				ss << "\nOPTIONS\n";
-				ss << format_options_description(c.options, indentation);
-			}
+ARGS_EXPORT namespace args {
+	inline constexpr std::size_t cache_line_size = 64;
+
+	struct flag_base {
+		field names;
+		bool is_flag = false;
+		void* value = nullptr;
+		value_errc (*parse_fun)(std::string_view, void*) = nullptr;
+	};
+}
+
+namespace args::detail {
+	template<typename T>
+	args::value_errc parse_flag_value(std::string_view value, void* destination) {
+		return parse_value(value, static_cast<T*>(destination));
+	}
+}
+
+ARGS_EXPORT namespace args {
+	template<typename T>
+	class flag {
+		private:
+
+		alignas(cache_line_size) T value;
+
+		public:
+
+		flag_base entry;
+
+		constexpr flag(const field& names, T value = T{})
+			: value(value),
+			entry{names, std::is_same<T, bool>::value, &this->value, &parse_flag_value<T>} {}
+
+		flag(const flag&) = delete;
 
-			return ss.str();
+		const T& get() const {
+			return this->value;
 		}
 
-		command_internal& get_command_by_name(const std::string& command_name) {
-			auto command_it = std::find_if(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
-				return c.name == command_name || c.alias == command_name;
-			});
-			if (command_it == std::end(this->commands)) {
-				throw std::runtime_error("No such command \"" + command_name + "\"");
-			}
-			return *command_it;
+		const T& operator*() const {
+			return this->value;
 		}
 
-		public:
+		const T* operator->() const {
+			return &this->value;
+		}
+	};
+}
 
-		parser& name(const std::string& name) {
-			this->cmd_name = name;
-			return *this;
+#if defined(__ELF__)
+extern "C" {
+	extern args::flag_base* const __start_args_flags[] __attribute__((weak));
+	extern args::flag_base* const __stop_args_flags[] __attribute__((weak));
+}
+
+ARGS_EXPORT namespace args {
+	inline std::span<flag_base* const> registered_flags() {
+		return {__start_args_flags, __stop_args_flags};
+	}
+}
+#else
+ARGS_EXPORT namespace args {
+	inline std::vector<flag_base*>& flag_registry() {
+		static auto registry = std::vector<flag_base*>{};
+		return registry;
+	}
+
+	inline std::span<flag_base* const> registered_flags() {
+		auto& registry = flag_registry();
+		return {registry.data(), registry.size()};
+	}
+}
+#endif
+
+namespace args::detail {
+	[[noreturn]] inline void raise_error(const args::error& err) {
+		auto name = err.option_name();
+		auto value = std::string{err.value};
+		switch (err.code) {
+			case args::errc::invalid_option:
+				throw_exception(args::invalid_option{name});
+			case args::errc::invalid_option_value:
+				throw_exception(args::invalid_option_value{name, value, err.reason_message()});
+			case args::errc::invalid_command_option_value:
+				throw_exception(args::invalid_command_option_value{err.command_name(), name, value, err.reason_message()});
+			case args::errc::invalid_arg_value:
+				throw_exception(args::invalid_arg_value{name, value, err.reason_message()});
+			case args::errc::invalid_command_arg_value:
+				throw_exception(args::invalid_command_arg_value{err.command_name(), name, value, err.reason_message()});
+			case args::errc::unexpected_arg:
+				throw_exception(args::unexpected_arg{value});
+			case args::errc::missing_command:
+				throw_exception(args::missing_command{});
+			case args::errc::missing_option:
+				throw_exception(args::missing_option{name});
+			case args::errc::missing_command_option:
+				throw_exception(args::missing_command_option{err.command_name(), name});
+			case args::errc::missing_arg:
+				throw_exception(args::missing_arg{name});
+			case args::errc::missing_command_arg:
+				throw_exception(args::missing_command_arg{err.command_name(), name});
+			default:
+				throw_exception(std::runtime_error{err.message()});
 		}
+	}
 
-		parser& description(const std::string& description) {
-			this->cmd_description = description;
-			return *this;
+#ifdef __cpp_lib_expected
+	inline std::expected<void, args::error> to_expected(const args::error& err) {
+		if (err) {
+			return std::unexpected{err};
 		}
+		return {};
+	}
+#endif
+}
 
-		parser& command_required() {
-			this->command_required_f = true;
-			return *this;
+#ifdef ARGS_RESPONSE_FILES
+namespace args::detail {
+	enum class response_char : unsigned char {
+		plain,
+		space,
+		special
+	};
+
+	inline constexpr auto response_chars = []{
+		auto chars = std::array<response_char, 256>{};
+		for (auto c : {' ', '\t', '\n', '\r', '\v', '\f'}) {
+			chars[static_cast<unsigned char>(c)] = response_char::space;
 		}
+		for (auto c : {'\'', '"', '\\'}) {
+			chars[static_cast<unsigned char>(c)] = response_char::special;
+		}
+		return chars;
+	}();
 
-		template<typename F>
-		parser& help(F help_fun) {
-			this->help_fun = help_fun;
-			return *this;
+	inline response_char response_char_of(char c) {
+		return response_chars[static_cast<unsigned char>(c)];
+	}
+
+	template<typename F>
+	error read_response_tokens(std::string_view text, std::deque<std::string>& words, F&& token) {
+		auto offset = std::size_t{0};
+		while (true) {
+			while (offset < text.size() && response_char_of(text[offset]) == response_char::space) {
+				offset++;
+			}
+			if (offset == text.size()) {
+				return {};
+			}
+			auto begin = offset;
+			while (offset < text.size() && response_char_of(text[offset]) == response_char::plain) {
+				offset++;
+			}
+			if (offset == text.size() || response_char_of(text[offset]) == response_char::space) {
+				if (auto err = token(text.substr(begin, offset - begin), true)) {
+					return err;
+				}
+				continue;
+			}
+			auto& word = words.emplace_back(text.substr(begin, offset - begin));
+			auto quote = '\0';
+			for (; offset < text.size(); offset++) {
+				auto c = text[offset];
+				if (quote) {
+					if (c == quote) {
+						quote = '\0';
+					} else if (c == '\\' && quote == '"' && offset + 1 < text.size()
+							&& (text[offset + 1] == '"' || text[offset + 1] == '\\')) {
+						word += text[++offset];
+					} else {
+						word += c;
+					}
+				} else if (c == '\'' || c == '"') {
+					quote = c;
+				} else if (c == '\\' && offset + 1 < text.size()) {
+					word += text[++offset];
+				} else if (response_char_of(c) == response_char::space) {
+					break;
+				} else {
+					word += c;
+				}
+			}
+			if (auto err = token(std::string_view{word}, false)) {
+				return err;
+			}
 		}
+	}
 
-		template<typename T>
-		parser& arg(T* destination) {
-			this->args.emplace_back(create_parse_fun(destination));
-			return *this;
+	inline bool is_response_file_token(std::string_view token) {
+#ifdef ARGS_BINARY_ARRAYS
+		if (token.starts_with(binary_array_prefix)) {
+			return false;
 		}
+#endif
+		return token.size() > 1 && token[0] == '@';
+	}
 
-		template<typename T>
-		parser& arg(const std::string& name, T* destination) {
-			this->args.emplace_back(name, create_parse_fun(destination));
-			return *this;
+	class response_files {
+		public:
+		std::vector<std::shared_ptr<const mapped_file>> files = {};
+		std::deque<std::string> words = {};
+		std::vector<const mapped_file*> including = {};
+		bool escaped = false;
+
+		error expand(std::vector<std::string_view>& tokens);
+
+		error expand_file(std::string_view token, std::vector<std::string_view>& tokens);
+	};
+
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE error response_files::expand(std::vector<std::string_view>& tokens) {
+		this->files.clear();
+		this->words.clear();
+		this->including.clear();
+		this->escaped = false;
+		auto first = std::find_if(std::begin(tokens), std::end(tokens), [](auto token) {
+			return token == "--" || is_response_file_token(token);
+		});
+		if (first == std::end(tokens) || *first == "--") {
+			return {};
+		}
+		auto input = std::vector<std::string_view>(first, std::end(tokens));
+		tokens.erase(first, std::end(tokens));
+		for (auto token : input) {
+			if (!this->escaped && is_response_file_token(token)) {
+				if (auto err = this->expand_file(token, tokens)) {
+					return err;
+				}
+			} else {
+				this->escaped = this->escaped || token == "--";
+				tokens.push_back(token);
+			}
 		}
+		return {};
+	}
 
-		template<typename T>
-		parser& arg(const std::string& name, const std::string& description, T* destination) {
-			this->args.emplace_back(name, description, create_parse_fun(destination));
-			return *this;
+	ARGS_INLINE error response_files::expand_file(std::string_view token, std::vector<std::string_view>& tokens) {
+		auto file = map_file(std::string{token.substr(1)});
+		auto code = errc::none;
+		if (!file) {
+			code = errc::invalid_response_file;
+		} else if (std::any_of(std::begin(this->including), std::end(this->including), [&](auto including) {
+			return including->device == file->device && including->inode == file->inode;
+		})) {
+			code = errc::recursive_response_file;
 		}
+		if (code != errc::none) {
+			auto err = error{code};
+			err.token = static_cast<int>(tokens.size()) + 1;
+			err.value = token;
+			return err;
+		}
+		this->files.push_back(file);
+		this->including.push_back(file.get());
+		auto err = read_response_tokens(file->text, this->words, [&](std::string_view word, bool plain) {
+			if (plain && !this->escaped && is_response_file_token(word)) {
+				return this->expand_file(word, tokens);
+			}
+			this->escaped = this->escaped || word == "--";
+			tokens.push_back(word);
+			return error{};
+		});
+		this->including.pop_back();
+		return err;
+	}
+#endif
+}
+#endif
 
-		template<typename T>
-		parser& arg(args::required_t, const std::string& name, T* destination) {
-			this->args.emplace_back(args::required, name, create_parse_fun(destination));
-			return *this;
+#ifdef ARGS_ARGUMENT_STREAMS
+namespace args::detail {
+	inline constexpr auto nul_args_chunk_size = std::size_t{1} << 20;
+	inline constexpr auto nul_args_batch_size = std::size_t{4096};
+
+	class nul_args_stream {
+		public:
+		std::vector<std::string_view> sources = {};
+		std::vector<std::string_view> tokens = {};
+		std::string buffer = ""s;
+		std::string value = ""s;
+
+		template<typename F>
+		error read(std::string_view source, F&& parse) {
+			auto fd = source == "-"sv ? STDIN_FILENO : ::open(std::string{source}.c_str(), O_RDONLY | O_CLOEXEC);
+			auto ok = fd >= 0;
+			auto err = error{};
+			if (ok) {
+				if (auto file = map_file(fd, false)) {
+					err = this->split(file->text, true, parse).first;
+				} else {
+					std::tie(ok, err) = this->read_chunks(fd, parse);
+				}
+			}
+			if (fd > STDIN_FILENO) {
+				::close(fd);
+			}
+			if (!ok) {
+				err = error{errc::invalid_args_stream};
+				err.value = source;
+			}
+			return err;
 		}
 
-		template<typename T>
-		parser& arg(args::required_t, const std::string& name, const std::string& description, T* destination) {
-			this->args.emplace_back(args::required, name, description, create_parse_fun(destination));
-			return *this;
+		private:
+		template<typename F>
+		std::pair<error, std::size_t> split(std::string_view text, bool last, F& parse) {
+			this->tokens.clear();
+			auto offset = std::size_t{0};
+			while (offset < text.size()) {
+				auto end = static_cast<const char*>(std::memchr(text.data() + offset, '\0', text.size() - offset));
+				if (!end && !last) {
+					break;
+				}
+				auto size = end ? static_cast<std::size_t>(end - text.data()) - offset : text.size() - offset;
+				this->tokens.push_back(text.substr(offset, size));
+				offset += size + 1;
+				if (this->tokens.size() == nul_args_batch_size) {
+					if (auto err = parse(std::span<const std::string_view>{this->tokens})) {
+						return {err, offset};
+					}
+					this->tokens.clear();
+				}
+			}
+			if (!this->tokens.empty()) {
+				if (auto err = parse(std::span<const std::string_view>{this->tokens})) {
+					return {err, offset};
+				}
+			}
+			return {error{}, std::min(offset, text.size())};
 		}
 
-		template<typename T, typename F>
-		parser& arg(F handler) {
-			this->args.emplace_back(create_parse_fun<T>(handler));
-			return *this;
+		template<typename F>
+		std::pair<bool, error> read_chunks(int fd, F& parse) {
+			this->buffer.resize(nul_args_chunk_size);
+			auto filled = std::size_t{0};
+			while (true) {
+				auto size = ::read(fd, this->buffer.data() + filled, this->buffer.size() - filled);
+				if (size < 0 && errno == EINTR) {
+					continue;
+				}
+				if (size < 0) {
+					return {false, error{}};
+				}
+				filled += static_cast<std::size_t>(size);
+				auto [err, consumed] = this->split({this->buffer.data(), filled}, size == 0, parse);
+				if (err || size == 0) {
+					return {true, err};
+				}
+				filled -= consumed;
+				std::memmove(this->buffer.data(), this->buffer.data() + consumed, filled);
+				if (filled == this->buffer.size()) {
+					this->buffer.resize(this->buffer.size() * 2);
+				}
+			}
 		}
+	};
+}
+#endif
 
-		template<typename T, typename F>
-		parser& arg(const std::string& name, F handler) {
-			this->args.emplace_back(name, create_parse_fun<T>(handler));
-			return *this;
+#ifdef ARGS_UNIX_SOCKETS
+ARGS_EXPORT namespace args {
+	class parser;
+}
+
+namespace args::detail {
+	[[noreturn]] inline void serve_invocation(const args::parser& schema, int connection);
+}
+#endif
+
+ARGS_EXPORT namespace args {
+	struct plugin_info {
+		std::string name = ""s;
+		std::string alias = ""s;
+		std::string description = ""s;
+		std::string library = ""s;
+	};
+
+	class parse_context {
+		private:
+		friend class parser;
+
+		std::vector<std::string_view> tokens = {};
+		detail::seen_targets global = {};
+		detail::seen_targets command_targets = {};
+		const detail::command_internal* matched_command = nullptr;
+		void* values = nullptr;
+		const void* values_type = nullptr;
+		detail::rest_pools rest_pools = {};
+#ifdef ARGS_RESPONSE_FILES
+		detail::response_files response_files = {};
+#endif
+#ifdef ARGS_ARGUMENT_STREAMS
+		detail::nul_args_stream nul_args = {};
+#endif
+
+		void reset(std::size_t options_count, std::size_t args_count) {
+			this->global.reset(options_count, args_count);
+			this->command_targets.reset(0, 0);
+			this->matched_command = nullptr;
 		}
 
-		template<typename T, typename F>
-		parser& arg(const std::string& name, const std::string& description, F handler) {
-			this->args.emplace_back(name, description, create_parse_fun<T>(handler));
-			return *this;
+		public:
+		std::string_view command() const {
+			return this->matched_command ? std::string_view{this->matched_command->name} : std::string_view{};
+		}
+	};
+
+	class parser : private detail::registrar<parser> {
+		private:
+		friend detail::registrar<parser>;
+		friend class repl;
+#ifdef ARGS_UNIX_SOCKETS
+		friend void detail::serve_invocation(const parser& schema, int connection);
+#endif
+
+		std::string cmd_name = "";
+		std::string cmd_description = "";
+		bool command_required_f = false;
+		std::vector<command_internal> commands = {};
+		std::function<void ()> help_fun;
+		parse_context context = {};
+#ifdef ARGS_EXTERNAL_COMMANDS
+		std::string external_prefix = ""s;
+		std::string external_cache = ""s;
+
+		void exec_external(const parse_context& context, const error& err, int argc, const char** argv) const;
+#endif
+#ifdef ARGS_RESPONSE_FILES
+		bool response_files_f = false;
+#endif
+#ifdef ARGS_ARGUMENT_STREAMS
+		std::string nul_args_name = ""s;
+#endif
+
+		std::string format_command_usage(const command_internal& c, const std::string& indentation = default_indentation) const;
+
+		std::string format_command_help(const command_internal& c, const std::string& indentation = default_indentation) const;
+
+		const command_internal& get_command_by_name(const std::string& command_name) const {
+			auto command_it = std::find_if(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
+				return c.name == command_name || c.alias == command_name;
+			});
+			if (command_it == std::end(this->commands)) {
+				throw_exception(std::runtime_error("No such command \"" + command_name + "\""));
+			}
+			return command_it->built();
+		}
+
+		error parse_internal(parse_context& context, int argc, const char** argv) const;
+
+		void write_help(const error& err) const {
+			if (this->help_fun) {
+				this->help_fun();
+			} else if (err.command.empty()) {
+				write_text(this->format_help());
+			} else {
+				write_text(this->format_command_help(this->get_command_by_name(std::string{err.command})));
+			}
+		}
+
+		void show_help(const error& err) const {
+			this->write_help(err);
+			if (!this->help_fun) {
+				std::exit(0);
+			}
+		}
+
+		template<typename F>
+		command_internal& lazy_command(command_internal& command, F builder) {
+			command.builder = std::make_shared<command_builder>();
+			command.builder->build = builder;
+			return command;
+		}
+
+		command_internal& share_layout(command_internal& command) {
+			if (!this->layout) {
+				this->layout = std::make_shared<result_layout>();
+			}
+			command.layout = this->layout;
+			return command;
+		}
+
+		void field_option(const args::field& field, bool is_flag, parse_fun_t parse_fun) {
+			if (field.long_name_or_desc.empty()) {
+				this->options.emplace_back(std::string{field.name}, "", "", "",
+						field.required, is_flag, parse_fun);
+			} else {
+				this->options.emplace_back("", std::string{field.name}, std::string{field.long_name_or_desc}, std::string{field.description},
+						field.required, is_flag, parse_fun);
+			}
+		}
+
+		template<typename T>
+		void bind_field(T& member, const args::field& field) {
+			this->field_option(field, std::is_same<T, bool>::value, args::value_parser(&member));
+		}
+
+		public:
+		using detail::registrar<parser>::option;
+		using detail::registrar<parser>::arg;
+		using detail::registrar<parser>::rest;
+		using detail::registrar<parser>::rest_parallel;
+		using detail::registrar<parser>::rest_bulk;
+
+		parser& name(const std::string& name) {
+			this->cmd_name = name;
+			return *this;
+		}
+
+		parser& description(const std::string& description) {
+			this->cmd_description = description;
+			return *this;
+		}
+
+		parser& command_required() {
+			this->command_required_f = true;
+			return *this;
+		}
+
+		template<typename F>
+		parser& help(F help_fun) {
+			this->help_fun = help_fun;
+			return *this;
+		}
+
+		template<typename T, std::size_t N>
+		parser& bind(T* destination, const args::field (&fields)[N]) {
+			static_assert(std::is_aggregate<T>::value, "Only aggregates could be bound");
+			static_assert(field_count<T>() == N, "Number of fields should match number of struct members");
+			this->options.reserve(this->options.size() + N);
+			auto field = std::begin(fields);
+			std::apply([&](auto&... members) {
+				(this->bind_field(members, *field++), ...);
+			}, tie_fields(*destination));
+			return *this;
+		}
+
+		parser& flags() {
+			auto flags = registered_flags();
+			this->options.reserve(this->options.size() + flags.size());
+			for (auto flag : flags) {
+				this->field_option(flag->names, flag->is_flag, [flag](std::string_view value, void*) {
+					return flag->parse_fun(value, flag->value);
+				});
+			}
+			return *this;
+		}
+
+		command_internal& command(const std::string& name) {
+			return this->share_layout(this->commands.emplace_back(name));
+		}
+
+		command_internal& command(const std::string& name, const std::string& alias_or_desc) {
+			return this->share_layout(this->commands.emplace_back(name, alias_or_desc));
+		}
+
+		command_internal& command(const std::string& name, const std::string& alias, const std::string& description) {
+			return this->share_layout(this->commands.emplace_back(name, alias, description));
+		}
+
+		command_internal& command(const std::string& name, bool* destination) {
+			return this->share_layout(this->commands.emplace_back(name, destination));
+		}
+
+		command_internal& command(const std::string& name, const std::string& alias_or_desc, bool* destination) {
+			return this->share_layout(this->commands.emplace_back(name, alias_or_desc, destination));
+		}
+
+		command_internal& command(const std::string& name, const std::string& alias, const std::string& description, bool* destination) {
+			return this->share_layout(this->commands.emplace_back(name, alias, destination));
+		}
+
+#ifdef ARGS_PLUGINS
+		parser& plugins(const std::vector<args::plugin_info>& plugins);
+#endif
+
+#ifdef ARGS_EXTERNAL_COMMANDS
+		parser& external_commands(const std::string& prefix, const std::string& cache_path) {
+			this->external_prefix = prefix;
+			this->external_cache = cache_path;
+			return *this;
+		}
+#endif
+
+#ifdef ARGS_RESPONSE_FILES
+		parser& response_files() {
+			this->response_files_f = true;
+			return *this;
+		}
+#endif
+
+#ifdef ARGS_ARGUMENT_STREAMS
+		parser& nul_args(const std::string& name) {
+			return this->nul_args(name, "");
+		}
+
+		parser& nul_args(const std::string& name, const std::string& description) {
+			this->nul_args_name = name;
+			return this->add_option(name, "", "", description, false, false, [](std::string_view, void*) {
+				return args::value_errc::none;
+			});
+		}
+#endif
+
+		template<typename F>
+		std::enable_if_t<std::is_invocable<F, command_internal&>::value, command_internal&>
+		command(const std::string& name, F builder) {
+			return this->lazy_command(this->command(name), builder);
+		}
+
+		template<typename F>
+		std::enable_if_t<std::is_invocable<F, command_internal&>::value, command_internal&>
+		command(const std::string& name, const std::string& alias_or_desc, F builder) {
+			return this->lazy_command(this->command(name, alias_or_desc), builder);
+		}
+
+		template<typename F>
+		std::enable_if_t<std::is_invocable<F, command_internal&>::value, command_internal&>
+		command(const std::string& name, const std::string& alias, const std::string& description, F builder) {
+			return this->lazy_command(this->command(name, alias, description), builder);
+		}
+
+		parser& reset() {
+			this->context.reset(this->options.size(), this->args.size());
+			return *this;
+		}
+
+		void parse(parse_context& context, int argc, const char** argv) const {
+			context.values = nullptr;
+			context.values_type = nullptr;
+			auto err = this->parse_internal(context, argc, argv);
+			if (err.code == errc::help_requested) {
+				this->show_help(err);
+			} else if (err) {
+#ifdef ARGS_EXTERNAL_COMMANDS
+				this->exec_external(context, err, argc, argv);
+#endif
+				raise_error(err);
+			}
+		}
+
+		template<typename T>
+		void parse(parse_context& context, T& values, int argc, const char** argv) const {
+			context.values = &values;
+			context.values_type = &type_tag<T>;
+			auto err = this->parse_internal(context, argc, argv);
+			if (err.code == errc::help_requested) {
+				this->show_help(err);
+			} else if (err) {
+#ifdef ARGS_EXTERNAL_COMMANDS
+				this->exec_external(context, err, argc, argv);
+#endif
+				raise_error(err);
+			}
+		}
+
+		void parse(parse_context& context, result& values, int argc, const char** argv) const {
+			values.prepare(this->layout);
+			this->parse<result>(context, values, argc, argv);
+		}
+
+		void parse(int argc, const char** argv) {
+			this->parse(this->context, argc, argv);
+		}
+
+#ifdef __cpp_lib_expected
+		std::expected<void, error> try_parse(parse_context& context, int argc, const char** argv) const {
+			context.values = nullptr;
+			context.values_type = nullptr;
+			return to_expected(this->parse_internal(context, argc, argv));
+		}
+
+		template<typename T>
+		std::expected<void, error> try_parse(parse_context& context, T& values, int argc, const char** argv) const {
+			context.values = &values;
+			context.values_type = &type_tag<T>;
+			return to_expected(this->parse_internal(context, argc, argv));
+		}
+
+		std::expected<void, error> try_parse(parse_context& context, result& values, int argc, const char** argv) const {
+			values.prepare(this->layout);
+			return this->try_parse<result>(context, values, argc, argv);
+		}
+
+		std::expected<void, error> try_parse(int argc, const char** argv) {
+			return this->try_parse(this->context, argc, argv);
+		}
+#endif
+
+		std::string format_usage(const std::string& indentation = default_indentation) const;
+
+		std::string format_commands(const std::string& indentation = default_indentation) const;
+
+		std::string format_command_usage(const std::string& command_name, const std::string& indentation = default_indentation) const {
+			auto& c = this->get_command_by_name(command_name);
+			return format_command_usage(c, indentation);
+		}
+
+		std::string format_args(const std::string& indentation = default_indentation) const {
+			return format_args_description(this->args, this->rest_args, indentation);
+		}
+
+		std::string format_command_args(const std::string& command_name, const std::string& indentation = default_indentation) const {
+			auto& c = this->get_command_by_name(command_name);
+			return format_args_description(c.args, c.rest_args, indentation);
+		}
+
+		std::string format_options(const std::string& indentation = default_indentation) const {
+			return format_options_description(this->options, indentation);
+		}
+
+		std::string format_command_options(const std::string& command_name, const std::string& indentation = default_indentation) const {
+			auto& c = this->get_command_by_name(command_name);
+			return format_options_description(c.options, indentation);
+		}
+
+		std::string format_help(const std::string& indentation = default_indentation) const;
+
+		std::string format_command_help(const std::string& command_name, const std::string& indentation = default_indentation) const {
+			auto& c = this->get_command_by_name(command_name);
+			return format_command_help(c, indentation);
+		}
+
+		std::string format_man(const std::string& section = "1"s) const;
+	};
+
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE std::string parser::format_command_usage(const command_internal& c, const std::string& indentation) const {
+		auto ss = std::stringstream{};
+		auto names = std::vector<std::string>{c.name};
+		if (!c.alias.empty()) {
+			names.push_back(c.alias);
+		}
+
+		auto cmd_name = this->cmd_name.empty() ? "CMD" : this->cmd_name;
+		auto first = true;
+		std::for_each(std::begin(names), std::end(names), [&](auto& name) {
+			if (!first) {
+				ss << "\n";
+			}
+			first = false;
+			ss << indentation << cmd_name;
+			ss << format_usage_options(this->options);
+			ss << format_usage_args(this->args, this->rest_args);
+			ss << " " << name;
+			ss << format_usage_options(c.options);
+			ss << format_usage_args(c.args, c.rest_args);
+		});
+		ss << "\n";
+		return ss.str();
+	}
+
+	ARGS_INLINE std::string parser::format_command_help(const command_internal& c, const std::string& indentation) const {
+		auto ss = std::stringstream{};
+		ss << "USAGE\n";
+		ss << format_command_usage(c, indentation);
+
+		if (!c.description.empty()) {
+			ss << "\nDESCRIPTION\n";
+			ss << indentation << c.description << "\n";
+		}
+
+		if (c.args.size() > 0 || c.rest_args.parse_fun) {
+			ss << "\nARGUMENTS\n";
+			ss << format_args_description(c.args, c.rest_args, indentation);
+		}
+
+		if (c.options.size() > 0) {
+			ss << "\nOPTIONS\n";
+			ss << format_options_description(c.options, indentation);
+		}
+
+		return ss.str();
+	}
+
+	ARGS_INLINE error parser::parse_internal(parse_context& context, int argc, const char** argv) const {
+		auto check_values_type = [&](const void* values_type) {
+			if (values_type && values_type != context.values_type) {
+				throw_exception(std::runtime_error("Member targets need values of the struct they belong to"));
+			}
+		};
+		check_values_type(this->values_type);
+		context.reset(this->options.size(), this->args.size());
+		context.tokens.assign(argv + std::min(argc, 1), argv + argc);
+#ifdef ARGS_RESPONSE_FILES
+		if (this->response_files_f) {
+			if (auto err = context.response_files.expand(context.tokens)) {
+				return err;
+			}
+		}
+#endif
+#ifdef ARGS_ARGUMENT_STREAMS
+		context.nul_args.sources.clear();
+#endif
+		auto& args = context.tokens;
+
+		auto command_it = static_cast<const command_internal*>(nullptr);
+		auto is_command_option = false;
+		auto find_option_if = [&](auto&& pred) -> const args::option* {
+			if (command_it) {
+				auto command_option_it = std::find_if(std::begin(command_it->options), std::end(command_it->options), pred);
+				if (command_option_it != std::end(command_it->options)) {
+					is_command_option = true;
+					return &*command_option_it;
+				}
+			}
+			auto global_option_it = std::find_if(std::begin(this->options), std::end(this->options), pred);
+			if (global_option_it != std::end(this->options)) {
+				is_command_option = false;
+				return &*global_option_it;
+			} else {
+				is_command_option = false;
+				return nullptr;
+			}
+		};
+
+		auto token_index = [&](auto it) {
+			return static_cast<int>(std::distance(std::begin(args), it)) + 1;
+		};
+
+#ifdef __cpp_exceptions
+		auto cause = std::exception_ptr{};
+#endif
+		auto parse_value_of = [&](auto& target, std::string_view value) {
+#ifdef __cpp_exceptions
+			try {
+				return target.parse_fun(value, context.values);
+			} catch (const std::runtime_error&) {
+				cause = std::current_exception();
+				return value_errc::handler;
+			}
+#else
+			return target.parse_fun(value, context.values);
+#endif
+		};
+
+		auto parse_target = [&](auto& target, auto& seen, std::string_view value) {
+			auto reason = parse_value_of(target, value);
+			if (reason == value_errc::none) {
+				seen = true;
+			}
+			return reason;
+		};
+
+		auto& global_rest_pool = context.rest_pools.global;
+		auto& command_rest_pool = context.rest_pools.command;
+		auto stop_rest_pools = rest_pools_guard{context.rest_pools};
+		auto parse_rest = [&](const arg_internal& rest, char& seen, std::string_view value, int token, std::unique_ptr<rest_pool>& pool) {
+			if (!rest.parallel_fun) {
+				return parse_target(rest, seen, value);
+			}
+			auto work = rest_work_t{};
+			auto reason = rest.parallel_fun(value, work);
+			if (reason == value_errc::none) {
+				if (!pool || (!pool->active && pool->size() != rest.threads_count)) {
+					pool = std::make_unique<rest_pool>(rest.threads_count);
+				}
+				if (!pool->active) {
+					pool->start(rest.ordered);
+				}
+				pool->submit(std::move(work), token);
+				pool->commit_ready();
+				seen = true;
+			}
+			return reason;
+		};
+
+		auto option_seen = [&](const args::option* option) -> char& {
+			if (is_command_option) {
+				return context.command_targets.options[option - command_it->options.data()];
+			}
+			return context.global.options[option - this->options.data()];
+		};
+
+		auto option_value_error = [&](auto arg, std::string_view name, auto value_arg, std::string_view value, value_errc reason) {
+			auto err = error{is_command_option ? errc::invalid_command_option_value : errc::invalid_option_value, reason};
+			err.token = token_index(arg);
+			err.value_token = token_index(value_arg);
+			err.name = name;
+			err.value = value;
+			if (is_command_option) {
+				err.command = command_it->name;
+				err.command_alias = command_it->alias;
+			}
+#ifdef __cpp_exceptions
+			err.cause = cause;
+#endif
+			return err;
+		};
+
+		auto token_value_error = [&](int token, std::string_view value, std::string_view name, value_errc reason, bool is_command_arg) {
+			auto err = error{is_command_arg ? errc::invalid_command_arg_value : errc::invalid_arg_value, reason};
+			err.token = token;
+			err.value_token = err.token;
+			err.name = name;
+			err.value = value;
+			if (is_command_arg) {
+				err.command = command_it->name;
+			}
+#ifdef __cpp_exceptions
+			err.cause = cause;
+#endif
+			return err;
+		};
+
+		auto arg_value_error = [&](auto arg, std::string_view name, value_errc reason, bool is_command_arg) {
+			return token_value_error(token_index(arg), *arg, name, reason, is_command_arg);
+		};
+
+		auto parse_values_of = [&](auto& target, auto begin, auto end, std::size_t& failed) {
+			auto values = std::span<const std::string_view>{begin, end};
+#ifdef __cpp_exceptions
+			try {
+				return target.bulk_fun(values, context.values, failed);
+			} catch (const std::runtime_error&) {
+				cause = std::current_exception();
+				return value_errc::handler;
+			}
+#else
+			return target.bulk_fun(values, context.values, failed);
+#endif
+		};
+
+		auto parse_bulk = [&](const arg_internal& rest, char& seen, auto arg, bool is_command_arg) {
+			auto failed = std::size_t{0};
+			auto reason = parse_values_of(rest, arg, std::end(args), failed);
+			if (reason != value_errc::none) {
+				return arg_value_error(arg + failed, rest.name, reason, is_command_arg);
+			}
+			seen = true;
+			return error{};
+		};
+
+		auto args_only = false;
+		auto arg_index = 0;
+		auto command_arg_index = 0;
+		for (auto arg = std::begin(args); arg != std::end(args); arg++) {
+			if (*arg == "--"sv) {
+				args_only = true;
+				continue;
+			}
+
+			if (!args_only) {
+				if (*arg == "--help"sv) {
+					auto err = error{errc::help_requested};
+					err.token = token_index(arg);
+					if (command_it) {
+						err.command = command_it->name;
+						err.command_alias = command_it->alias;
+					}
+					return err;
+				}
+
+#ifdef ARGS_ARGUMENT_STREAMS
+				if (!this->nul_args_name.empty() && (*arg == this->nul_args_name || is_assignment(*arg, this->nul_args_name))) {
+					if (*arg != this->nul_args_name) {
+						context.nul_args.sources.push_back(arg->substr(this->nul_args_name.size() + 1));
+					} else if (std::next(arg) != std::end(args)) {
+						context.nul_args.sources.push_back(*++arg);
+					} else {
+						is_command_option = false;
+						return option_value_error(arg, *arg, arg, ""sv, value_errc::empty);
+					}
+					continue;
+				}
+#endif
+
+				auto option_it = find_option_if([&](auto& o) {
+					return (!o.short_name.empty() && arg->starts_with(o.short_name))
+						|| (!o.long_name.empty() && arg->starts_with(o.long_name))
+						|| (!o.non_conventional.empty() && arg->starts_with(o.non_conventional));
+				});
+
+				if (!option_it && arg->starts_with("--no-")) {
+					auto name = arg->substr(5);
+					option_it = find_option_if([&](auto& o) {
+						return o.long_name.size() == name.size() + 2 && o.long_name.starts_with("--") && o.long_name.ends_with(name);
+					});
+
+					if (!option_it || !option_it->is_flag) {
+						option_it = nullptr;
+					}
+				}
+
+				if (!option_it && arg->starts_with('-')) {
+					auto err = error{errc::invalid_option};
+					err.token = token_index(arg);
+					err.name = *arg;
+					return err;
+				}
+
+				if (option_it) {
+					if (*arg == option_it->short_name || *arg == option_it->long_name
+							|| *arg == option_it->non_conventional) {
+
+						if (option_it->is_flag) {
+							auto next = std::next(arg);
+							if (next != std::end(args) && is_valid_flag_value(*next)) {
+								auto reason = parse_target(*option_it, option_seen(option_it), *next);
+								if (reason != value_errc::none) {
+									return option_value_error(arg, *arg, next, *next, reason);
+								}
+								arg++;
+							} else {
+								auto reason = parse_target(*option_it, option_seen(option_it), "1"sv);
+								if (reason != value_errc::none) {
+									return option_value_error(arg, *arg, arg, "1"sv, reason);
+								}
+							}
+						} else if (option_it->bulk_fun) {
+							auto begin = std::next(arg);
+							auto end = begin;
+							while (end != std::end(args) && !end->starts_with("-")
+									&& static_cast<std::size_t>(std::distance(begin, end)) < option_it->max_values) {
+								end++;
+							}
+							if (static_cast<std::size_t>(std::distance(begin, end)) < option_it->min_values) {
+								return option_value_error(arg, *arg, end == begin ? arg : std::prev(end), ""sv, value_errc::not_enough_values);
+							}
+							auto failed = std::size_t{0};
+							auto reason = parse_values_of(*option_it, begin, end, failed);
+							if (reason != value_errc::none) {
+								auto value_arg = begin == end ? arg : begin + failed;
+								return option_value_error(arg, *arg, value_arg, begin == end ? ""sv : *value_arg, reason);
+							}
+							option_seen(option_it) = true;
+							arg = std::prev(end);
+						} else {
+							auto next = std::next(arg);
+							if (next != std::end(args) && !next->starts_with("-")) {
+								auto reason = parse_target(*option_it, option_seen(option_it), *next);
+								if (reason != value_errc::none) {
+									return option_value_error(arg, *arg, next, *next, reason);
+								}
+								arg++;
+							} else {
+								return option_value_error(arg, *arg, arg, ""sv, value_errc::empty);
+							}
+						}
+					} else if (is_assignment(*arg, option_it->short_name)
+							|| is_assignment(*arg, option_it->long_name)
+							|| is_assignment(*arg, option_it->non_conventional)) {
+
+						auto value = arg->substr(arg->find("=") + 1);
+						auto reason = parse_target(*option_it, option_seen(option_it), value);
+						if (reason != value_errc::none) {
+							return option_value_error(arg, arg->substr(0, arg->find("=")), arg, value, reason);
+						}
+					} else if (!option_it->short_name.empty() && arg->starts_with(option_it->short_name)
+							&& option_it->is_flag) {
+
+						auto is_short_grouped = std::all_of(std::begin(*arg) + 1, std::end(*arg), [&](auto& c) {
+							auto option_it = find_option_if([&](auto& o) {
+								return is_short_name_of(o.short_name, c);
+							});
+							return option_it && option_it->is_flag;
+						});
+						if (is_short_grouped) {
+							for (auto c = std::begin(*arg) + 1; c != std::end(*arg); c++) {
+								auto option_it = find_option_if([&](auto& o) {
+									return is_short_name_of(o.short_name, *c);
+								});
+								auto reason = parse_target(*option_it, option_seen(option_it), "1"sv);
+								if (reason != value_errc::none) {
+									return option_value_error(arg, option_it->short_name, arg, "1"sv, reason);
+								}
+							}
+						} else if (is_valid_flag_value(arg->substr(2))) {
+							auto reason = parse_target(*option_it, option_seen(option_it), arg->substr(2));
+							if (reason != value_errc::none) {
+								return option_value_error(arg, arg->substr(0, 2), arg, arg->substr(2), reason);
+							}
+						} else {
+							auto err = error{errc::invalid_option};
+							err.token = token_index(arg);
+							err.name = *arg;
+							return err;
+						}
+					} else if (!option_it->short_name.empty() && arg->starts_with(option_it->short_name)
+							&& !option_it->is_flag) {
+
+						auto value = arg->substr(2);
+						auto reason = parse_target(*option_it, option_seen(option_it), value);
+						if (reason != value_errc::none) {
+							return option_value_error(arg, arg->substr(0, 2), arg, value, reason);
+						}
+					} else if (arg->starts_with("--no-")) {
+						auto reason = parse_target(*option_it, option_seen(option_it), "0"sv);
+						if (reason != value_errc::none) {
+							return option_value_error(arg, *arg, arg, "0"sv, reason);
+						}
+					}
+
+					continue;
+				}
+			}
+
+			if (!args_only && !command_it) {
+				auto inspected = std::size_t{0};
+				for (auto c = std::begin(this->commands); c != std::end(this->commands); c++) {
+					auto words = std::max(command_words(c->name, arg, std::end(args), inspected),
+						command_words(c->alias, arg, std::end(args), inspected));
+					if (words > 0) {
+						command_it = &c->built();
+						arg += words - 1;
+						break;
+					}
+				}
+
+				if (command_it) {
+					check_values_type(command_it->values_type);
+					context.command_targets.reset(command_it->options.size(), command_it->args.size());
+					context.matched_command = command_it;
+					if (command_it->destination) {
+						*command_it->destination = true;
+					}
+					continue;
+				}
+			}
+
+			if (command_it) {
+				if (command_it->args.size() > command_arg_index) {
+					auto reason = parse_target(command_it->args[command_arg_index], context.command_targets.args[command_arg_index], *arg);
+					if (reason != value_errc::none) {
+						return arg_value_error(arg, command_it->args[command_arg_index].name, reason, true);
+					}
+					command_arg_index++;
+					continue;
+				} else if (command_it->rest_args.parse_fun) {
+					if (args_only && command_it->rest_args.bulk_fun) {
+						if (auto err = parse_bulk(command_it->rest_args, context.command_targets.rest, arg, true)) {
+							return err;
+						}
+						break;
+					}
+					auto reason = parse_rest(command_it->rest_args, context.command_targets.rest, *arg, token_index(arg), command_rest_pool);
+					if (reason != value_errc::none) {
+						return arg_value_error(arg, command_it->rest_args.name, reason, true);
+					}
+					continue;
+				}
+			}
+
+			if (this->args.size() > arg_index) {
+				auto reason = parse_target(this->args[arg_index], context.global.args[arg_index], *arg);
+				if (reason != value_errc::none) {
+					return arg_value_error(arg, this->args[arg_index].name, reason, false);
+				}
+				arg_index++;
+			} else if (this->rest_args.parse_fun) {
+				if (args_only && this->rest_args.bulk_fun) {
+					if (auto err = parse_bulk(this->rest_args, context.global.rest, arg, false)) {
+						return err;
+					}
+					break;
+				}
+				auto reason = parse_rest(this->rest_args, context.global.rest, *arg, token_index(arg), global_rest_pool);
+				if (reason != value_errc::none) {
+					return arg_value_error(arg, this->rest_args.name, reason, false);
+				}
+			} else {
+				auto err = error{errc::unexpected_arg};
+				err.token = token_index(arg);
+				err.value_token = err.token;
+				err.value = *arg;
+				return err;
+			}
+		}
+
+#ifdef ARGS_ARGUMENT_STREAMS
+		auto stream_token = static_cast<int>(args.size()) + 1;
+		for (auto source : context.nul_args.sources) {
+			auto is_command_arg = command_it && command_it->rest_args.parse_fun;
+			auto& rest = is_command_arg ? command_it->rest_args : this->rest_args;
+			auto& seen = is_command_arg ? context.command_targets.rest : context.global.rest;
+			auto& pool = is_command_arg ? command_rest_pool : global_rest_pool;
+			auto err = context.nul_args.read(source, [&](std::span<const std::string_view> values) {
+				auto failed = std::size_t{0};
+				auto reason = value_errc::none;
+				if (!rest.parse_fun) {
+					context.nul_args.value = values.front();
+					auto err = error{errc::unexpected_arg};
+					err.token = stream_token;
+					err.value_token = err.token;
+					err.value = context.nul_args.value;
+					return err;
+				} else if (rest.bulk_fun) {
+					reason = parse_values_of(rest, std::begin(values), std::end(values), failed);
+				} else {
+					for (; failed < values.size(); failed++) {
+						reason = parse_rest(rest, seen, values[failed], stream_token + static_cast<int>(failed), pool);
+						if (reason != value_errc::none) {
+							break;
+						}
+					}
+				}
+				if (reason != value_errc::none) {
+					context.nul_args.value = values[failed];
+					return token_value_error(stream_token + static_cast<int>(failed), context.nul_args.value, rest.name, reason, is_command_arg);
+				}
+				seen = true;
+				stream_token += static_cast<int>(values.size());
+				return error{};
+			});
+			if (err) {
+				return err;
+			}
+		}
+#endif
+
+		auto finish_rest = [&](std::unique_ptr<rest_pool>& pool, const arg_internal& rest, bool is_command_arg) {
+			auto err = error{};
+			if (pool && pool->active) {
+				pool->drain();
+#ifdef __cpp_exceptions
+				if (pool->failure) {
+					try {
+						std::rethrow_exception(pool->failure);
+					} catch (const std::runtime_error&) {
+						cause = pool->failure;
+						auto token = static_cast<std::size_t>(pool->failure_token);
+						err = token_value_error(pool->failure_token, token <= args.size() ? args[token - 1] : ""sv, rest.name, value_errc::handler, is_command_arg);
+					}
+				}
+#endif
+				pool->stop();
+			}
+			return err;
+		};
+		if (auto err = finish_rest(global_rest_pool, this->rest_args, false)) {
+			return err;
+		}
+		if (command_it) {
+			if (auto err = finish_rest(command_rest_pool, command_it->rest_args, true)) {
+				return err;
+			}
+		}
+
+		if (this->command_required_f && !command_it) {
+			return error{errc::missing_command};
+		}
+
+		auto missing_option = find_missing(this->options, context.global.options);
+		if (missing_option != std::end(this->options)) {
+			auto err = error{errc::missing_option};
+			err.option = &*missing_option;
+			return err;
+		}
+
+		auto missing_arg = find_missing(this->args, context.global.args);
+		if (missing_arg != std::end(this->args)) {
+			auto err = error{errc::missing_arg};
+			err.name = missing_arg->name;
+			return err;
+		}
+
+		if (this->rest_args.parse_fun && this->rest_args.required && !context.global.rest) {
+			auto err = error{errc::missing_arg};
+			err.name = this->rest_args.name;
+			return err;
+		}
+
+		if (command_it) {
+			auto missing_command_option = find_missing(command_it->options, context.command_targets.options);
+			if (missing_command_option != std::end(command_it->options)) {
+				auto err = error{errc::missing_command_option};
+				err.command = command_it->name;
+				err.command_alias = command_it->alias;
+				err.option = &*missing_command_option;
+				return err;
+			}
+
+			if (command_it->action_fun) {
+				command_it->action_fun();
+			}
+			if (command_it->values_action_fun) {
+				command_it->values_action_fun(context.values);
+			}
+
+			auto missing_command_arg = find_missing(command_it->args, context.command_targets.args);
+			if (missing_command_arg != std::end(command_it->args)) {
+				auto err = error{errc::missing_command_arg};
+				err.command = command_it->name;
+				err.command_alias = command_it->alias;
+				err.name = missing_command_arg->name;
+				return err;
+			}
+
+			if (command_it->rest_args.parse_fun && command_it->rest_args.required && !context.command_targets.rest) {
+				auto err = error{errc::missing_command_arg};
+				err.command = command_it->name;
+				err.command_alias = command_it->alias;
+				err.name = command_it->rest_args.name;
+				return err;
+			}
+		}
+
+		return {};
+	}
+
+	ARGS_INLINE std::string parser::format_usage(const std::string& indentation) const {
+		auto ss = std::stringstream{};
+		auto name = this->cmd_name.empty() ? "CMD" : this->cmd_name;
+
+		if (this->command_required_f) {
+			auto first = true;
+			std::for_each(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
+				if (!first) {
+					ss << "\n";
+				}
+				first = false;
+				ss << indentation << name;
+				ss << format_usage_options(this->options);
+				ss << format_usage_args(this->args, this->rest_args);
+				ss << " " << command_print_name(c, "|"s);
+				if (c.builder) {
+					ss << " ...";
+				} else {
+					ss << format_usage_options(c.options);
+					ss << format_usage_args(c.args, c.rest_args);
+				}
+			});
+		} else {
+			ss << "  " << name;
+			ss << format_usage_options(this->options);
+			ss << format_usage_args(this->args, this->rest_args);
+			if (this->commands.size() > 0) {
+				if (this->command_required_f) {
+					ss << " command ...";
+				} else {
+					ss << " [command] ...";
+				}
+			}
+		}
+		ss << "\n";
+		return ss.str();
+	}
+
+	ARGS_INLINE std::string parser::format_commands(const std::string& indentation) const {
+		auto ss = std::stringstream{};
+		auto first = true;
+		std::for_each(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
+			if (!first) {
+				ss << "\n";
+			}
+			first = false;
+			auto name = command_print_name(c);
+			if (name.size() <= max_label_width) {
+				ss << indentation << std::left << std::setw(max_label_width) << name << std::setw(0);
+				ss << "  ";
+			} else {
+				ss << indentation << name;
+				ss << "\n" << indentation << indentation;
+			}
+
+			if (!c.description.empty()) {
+				ss << c.description;
+			}
+		});
+		ss << "\n";
+		return ss.str();
+	}
+
+	ARGS_INLINE std::string parser::format_help(const std::string& indentation) const {
+		auto ss = std::stringstream{};
+		ss << "USAGE\n";
+		ss << this->format_usage(indentation);
+
+		if (!this->cmd_description.empty()) {
+			ss << "\nDESCRIPTION\n";
+			ss << indentation << this->cmd_description << "\n";
+		}
+
+		if (this->args.size() > 0 || this->rest_args.parse_fun) {
+			ss << "\nARGUMENTS\n";
+			ss << this->format_args(indentation);
+		}
+
+		if (this->options.size() > 0) {
+			ss << "\nOPTIONS\n";
+			ss << this->format_options(indentation);
+		}
+
+		if (this->commands.size() > 0) {
+			ss << "\nCOMMANDS\n";
+			ss << this->format_commands(indentation);
+		}
+
+		return ss.str();
+	}
+
+	ARGS_INLINE std::string parser::format_man(const std::string& section) const {
+		auto out = ""s;
+		auto w = [&](std::string_view str) {
+			out += str;
+		};
+		auto name = this->cmd_name.empty() ? "CMD"s : this->cmd_name;
+
+		w(".TH ");
+		write_roff(w, name, true);
+		w(" ");
+		w(section);
+		w("\n.SH NAME\n");
+		write_roff(w, name);
+		if (!this->cmd_description.empty()) {
+			w(" \\- ");
+			write_roff(w, this->cmd_description);
+		}
+
+		w("\n.SH SYNOPSIS\n.nf\n");
+		write_roff(w, this->format_usage(""));
+		w(".fi\n");
+
+		if (!this->cmd_description.empty()) {
+			w(".SH DESCRIPTION\n");
+			write_roff(w, this->cmd_description);
+			w("\n");
+		}
+
+		if (this->args.size() > 0 || this->rest_args.parse_fun) {
+			w(".SH ARGUMENTS\n");
+			for (auto& a : this->args) {
+				w(".TP\n.B ");
+				write_roff(w, a.name.empty() ? "ARG" : a.name);
+				w("\n");
+				write_roff(w, a.description);
+				w("\n");
+			}
+			if (this->rest_args.parse_fun) {
+				w(".TP\n.B ");
+				write_roff(w, this->rest_args.name.empty() ? "REST" : this->rest_args.name);
+				w("\n");
+				write_roff(w, this->rest_args.description);
+				w("\n");
+			}
+		}
+
+		if (this->options.size() > 0) {
+			w(".SH OPTIONS\n");
+			for (auto& o : this->options) {
+				w(".TP\n.B ");
+				write_roff(w, option_print_name(o));
+				w("\n");
+				if (o.required) {
+					w("Required! ");
+				}
+				write_roff(w, o.description);
+				w("\n");
+			}
+		}
+
+		if (this->commands.size() > 0) {
+			w(".SH COMMANDS\n");
+			for (auto& c : this->commands) {
+				w(".TP\n.B ");
+				write_roff(w, command_print_name(c));
+				w("\n");
+				write_roff(w, c.description);
+				w("\n");
+			}
+		}
+
+		return out;
+	}
+#endif
+
+	template<typename T, std::size_t N>
+	parser bind(T* destination, const field (&fields)[N]) {
+		return parser{}.bind(destination, fields);
+	}
+
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE void parse(int argc, const char** argv, const args::options& options) {
+		auto p = parser{};
+		for (auto& option : options) {
+			p.option(option);
+		}
+		p.parse(argc, argv);
+	}
+#else
+	void parse(int argc, const char** argv, const args::options& options);
+#endif
+
+	struct argv_view {
+		int argc = 0;
+		const char** argv = nullptr;
+	};
+}
+
+#ifdef __cpp_lib_expected
+namespace args::detail {
+	inline constexpr std::size_t batch_chunk_size = 64;
+
+	struct alignas(cache_line_size) batch_range {
+		std::atomic<std::size_t> next = 0;
+		std::size_t end = 0;
+	};
+
+	template<typename Values, typename Sink>
+	void parse_batch_input(const args::parser& schema, args::parse_context& context, const args::argv_view& input, std::size_t index, Sink& sink) {
+		if constexpr (std::is_void<Values>::value) {
+			sink(index, schema.try_parse(context, input.argc, input.argv));
+		} else {
+			auto values = Values{};
+			auto result = schema.try_parse(context, values, input.argc, input.argv);
+			if (result) {
+				sink(index, std::expected<Values, args::error>{std::move(values)});
+			} else {
+				sink(index, std::expected<Values, args::error>{std::unexpect, result.error()});
+			}
+		}
+	}
+}
+
+ARGS_EXPORT namespace args {
+	template<typename Values = void, typename Sink>
+	void parse_batch(const parser& schema, std::span<const argv_view> inputs, Sink sink,
+			std::size_t threads_count = std::thread::hardware_concurrency()) {
+
+		auto chunks_count = (inputs.size() + batch_chunk_size - 1) / batch_chunk_size;
+		threads_count = std::max<std::size_t>(1, std::min(threads_count, chunks_count));
+
+		auto ranges = std::vector<batch_range>(threads_count);
+		for (std::size_t t = 0; t < threads_count; t++) {
+			ranges[t].next = inputs.size() * t / threads_count;
+			ranges[t].end = inputs.size() * (t + 1) / threads_count;
+		}
+
+#ifdef __cpp_exceptions
+		auto failures = std::vector<std::exception_ptr>(threads_count);
+#endif
+		auto work = [&](std::size_t worker) {
+			auto context = parse_context{};
+			auto process = [&] {
+				for (std::size_t i = 0; i < threads_count; i++) {
+					auto& range = ranges[(worker + i) % threads_count];
+					while (true) {
+						auto begin = range.next.fetch_add(batch_chunk_size, std::memory_order_relaxed);
+						if (begin >= range.end) {
+							break;
+						}
+						auto end = std::min(begin + batch_chunk_size, range.end);
+						for (auto index = begin; index < end; index++) {
+							parse_batch_input<Values>(schema, context, inputs[index], index, sink);
+						}
+					}
+				}
+			};
+#ifdef __cpp_exceptions
+			try {
+				process();
+			} catch (...) {
+				failures[worker] = std::current_exception();
+			}
+#else
+			process();
+#endif
+		};
+
+		auto threads = std::vector<std::thread>{};
+		threads.reserve(threads_count - 1);
+		for (std::size_t t = 1; t < threads_count; t++) {
+			threads.emplace_back(work, t);
+		}
+		work(0);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+#ifdef __cpp_exceptions
+		for (auto& failure : failures) {
+			if (failure) {
+				std::rethrow_exception(failure);
+			}
+		}
+#endif
+	}
+}
+#endif
+
+#ifdef __cpp_lib_expected
+namespace args::detail {
+	struct repl_name {
+		std::string_view name = {};
+		const args::option* option = nullptr;
+		const command_internal* command = nullptr;
+		bool negated = false;
+	};
+
+	struct repl_index {
+		std::vector<repl_name> names = {};
+
+		void sort() {
+			std::sort(std::begin(this->names), std::end(this->names), [](auto& a, auto& b) {
+				return a.name < b.name;
+			});
+		}
+
+		auto lower_bound(std::string_view name) const {
+			return std::lower_bound(std::begin(this->names), std::end(this->names), name, [](auto& entry, auto name) {
+				return entry.name < name;
+			});
+		}
+
+		const repl_name* find(std::string_view name) const {
+			auto it = this->lower_bound(name);
+			return it != std::end(this->names) && it->name == name ? &*it : nullptr;
+		}
+
+		template<typename F>
+		void with_prefix(std::string_view prefix, F f) const {
+			for (auto it = this->lower_bound(prefix); it != std::end(this->names) && it->name.starts_with(prefix); it++) {
+				f(*it);
+			}
+		}
+	};
+
+	struct repl_state {
+		const command_internal* command = nullptr;
+		std::size_t command_index = 0;
+		bool args_only = false;
+		std::size_t arg_index = 0;
+		std::size_t command_arg_index = 0;
+	};
+
+	struct repl_step {
+		std::size_t begin = 0;
+		std::size_t end = 0;
+		std::size_t extent = 0;
+		std::size_t marks = 0;
+		repl_state state = {};
+		bool awaits_value = false;
+	};
+
+	struct repl_mark {
+		char* seen = nullptr;
+		char previous = false;
+	};
+
+	inline bool is_line_space(char c) {
+		return c == ' ' || c == '\t';
+	}
+
+	inline std::size_t read_word(std::string_view line, std::size_t offset, std::string& word) {
+		auto quote = '\0';
+		for (; offset < line.size(); offset++) {
+			auto c = line[offset];
+			if (quote) {
+				if (c == quote) {
+					quote = '\0';
+				} else if (c == '\\' && quote == '"' && offset + 1 < line.size()
+						&& (line[offset + 1] == '"' || line[offset + 1] == '\\')) {
+					word += line[++offset];
+				} else {
+					word += c;
+				}
+			} else if (c == '\'' || c == '"') {
+				quote = c;
+			} else if (c == '\\' && offset + 1 < line.size()) {
+				word += line[++offset];
+			} else if (is_line_space(c)) {
+				break;
+			} else {
+				word += c;
+			}
+		}
+		return offset;
+	}
+}
+
+ARGS_EXPORT namespace args {
+	class repl {
+		private:
+		static constexpr auto no_step = static_cast<std::size_t>(-1);
+
+		const parser* schema = nullptr;
+		std::deque<std::string> negated_names = {};
+		repl_index global_names = {};
+		std::vector<repl_index> command_option_names = {};
+		repl_index command_names = {};
+		seen_targets global_seen = {};
+		std::vector<seen_targets> command_seen = {};
+		std::vector<char> command_indexed = {};
+
+		std::string line = ""s;
+		std::deque<std::string> tokens = {};
+		std::vector<std::size_t> token_ends = {};
+		std::vector<repl_step> steps = {};
+		std::vector<repl_mark> marks = {};
+		repl_state state = {};
+		std::size_t stable = 0;
+		error scan_error = {};
+		std::size_t error_step = no_step;
+		error validation = {};
+		std::vector<std::string_view> completion_names = {};
+
+		parse_context context = {};
+		std::vector<const char*> argv = {};
+
+		void index_options(repl_index& index, const std::vector<args::option>& options);
+
+		const command_internal& index_command(std::size_t index);
+
+		void tokenize(std::size_t offset);
+
+		void scan(std::size_t changed);
+
+		std::size_t scan_token(std::size_t index);
+
+		error find_missing_target() const;
+
+		void complete();
+
+		void mark(char& seen) {
+			this->marks.push_back({&seen, seen});
+			seen = true;
+		}
+
+		void fail(const error& err) {
+			if (this->error_step == no_step) {
+				this->scan_error = err;
+				this->error_step = this->steps.size() - 1;
+			}
+		}
+
+		void prepare_argv() {
+			this->argv.clear();
+			this->argv.push_back(this->schema->cmd_name.c_str());
+			for (auto& token : this->tokens) {
+				this->argv.push_back(token.c_str());
+			}
+		}
+
+		public:
+		explicit repl(const parser& schema);
+
+		repl(const repl&) = delete;
+
+		repl& operator=(const repl&) = delete;
+
+		const error& update(std::string_view line);
+
+		std::span<const std::string_view> completions() const {
+			return this->completion_names;
+		}
+
+		std::string_view command() const {
+			return this->state.command ? std::string_view{this->state.command->name} : std::string_view{};
+		}
+
+		std::size_t stable_tokens() const {
+			return this->stable;
+		}
+
+		std::expected<void, error> execute() {
+			this->prepare_argv();
+			return this->schema->try_parse(this->context, static_cast<int>(this->argv.size()), this->argv.data());
+		}
+
+		template<typename T>
+		std::expected<void, error> execute(T& values) {
+			this->prepare_argv();
+			return this->schema->try_parse(this->context, values, static_cast<int>(this->argv.size()), this->argv.data());
+		}
+	};
+
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE repl::repl(const parser& schema)
+		: schema(&schema) {
+
+		this->index_options(this->global_names, schema.options);
+		this->global_seen.reset(schema.options.size(), schema.args.size());
+		this->command_option_names.resize(schema.commands.size());
+		this->command_seen.resize(schema.commands.size());
+		this->command_indexed.resize(schema.commands.size());
+		for (auto& c : schema.commands) {
+			this->command_names.names.push_back({c.name, nullptr, &c});
+			if (!c.alias.empty()) {
+				this->command_names.names.push_back({c.alias, nullptr, &c});
+			}
+		}
+		this->command_names.sort();
+	}
+
+	ARGS_INLINE void repl::index_options(repl_index& index, const std::vector<args::option>& options) {
+		for (auto& o : options) {
+			for (auto name : {&o.short_name, &o.long_name, &o.non_conventional}) {
+				if (!name->empty()) {
+					index.names.push_back({*name, &o});
+				}
+			}
+			if (o.is_flag && o.long_name.starts_with("--")) {
+				auto& negated = this->negated_names.emplace_back("--no-"s + o.long_name.substr(2));
+				index.names.push_back({negated, &o, nullptr, true});
+			}
+		}
+		index.sort();
+	}
+
+	ARGS_INLINE const command_internal& repl::index_command(std::size_t index) {
+		auto& c = this->schema->commands[index].built();
+		if (!this->command_indexed[index]) {
+			this->index_options(this->command_option_names[index], c.options);
+			this->command_seen[index].reset(c.options.size(), c.args.size());
+			this->command_indexed[index] = true;
+		}
+		return c;
+	}
+
+	ARGS_INLINE const error& repl::update(std::string_view line) {
+		auto changed = static_cast<std::size_t>(std::distance(std::begin(line),
+			std::mismatch(std::begin(line), std::end(line), std::begin(this->line), std::end(this->line)).first));
+		auto stable_count = std::size_t{0};
+		while (stable_count < this->token_ends.size() && this->token_ends[stable_count] < changed) {
+			stable_count++;
+		}
+
+		this->line.assign(line);
+		this->tokens.resize(stable_count);
+		this->token_ends.resize(stable_count);
+		this->tokenize(stable_count > 0 ? this->token_ends.back() : 0);
+
+		this->scan(stable_count);
+		this->validation = this->scan_error ? this->scan_error : this->find_missing_target();
+		this->complete();
+		return this->validation;
+	}
+
+	ARGS_INLINE void repl::tokenize(std::size_t offset) {
+		while (true) {
+			while (offset < this->line.size() && is_line_space(this->line[offset])) {
+				offset++;
+			}
+			if (offset == this->line.size()) {
+				return;
+			}
+			offset = read_word(this->line, offset, this->tokens.emplace_back());
+			this->token_ends.push_back(offset);
+		}
+	}
+
+	ARGS_INLINE void repl::scan(std::size_t changed) {
+		auto first = std::find_if(std::begin(this->steps), std::end(this->steps), [&](auto& step) {
+			return step.extent >= changed;
+		});
+		auto index = std::size_t{0};
+		auto marks_count = this->marks.size();
+		if (first != std::end(this->steps)) {
+			this->state = first->state;
+			index = first->begin;
+			marks_count = first->marks;
+		} else if (!this->steps.empty()) {
+			index = this->steps.back().end;
+		}
+
+		while (this->marks.size() > marks_count) {
+			auto& mark = this->marks.back();
+			*mark.seen = mark.previous;
+			this->marks.pop_back();
+		}
+		auto steps_count = static_cast<std::size_t>(std::distance(std::begin(this->steps), first));
+		this->steps.resize(steps_count);
+		if (this->error_step != no_step && this->error_step >= steps_count) {
+			this->scan_error = {};
+			this->error_step = no_step;
+		}
+
+		this->stable = index;
+		while (index < this->tokens.size()) {
+			index = this->scan_token(index);
+		}
+	}
+
+	ARGS_INLINE std::size_t repl::scan_token(std::size_t index) {
+		auto& step = this->steps.emplace_back();
+		step.begin = index;
+		step.extent = index;
+		step.marks = this->marks.size();
+		step.state = this->state;
+
+		auto& state = this->state;
+		auto& schema = *this->schema;
+		std::string_view token = this->tokens[index];
+		auto token_number = static_cast<int>(index) + 1;
+		auto next = index + 1;
+		auto command_index = state.command_index;
+
+		auto find_option = [&](std::string_view name, bool& is_command_option) -> const repl_name* {
+			if (state.command) {
+				if (auto entry = this->command_option_names[command_index].find(name)) {
+					is_command_option = true;
+					return entry;
+				}
+			}
+			is_command_option = false;
+			return this->global_names.find(name);
+		};
+
+		auto option_seen = [&](const args::option* option, bool is_command_option) -> char& {
+			if (is_command_option) {
+				return this->command_seen[command_index].options[option - state.command->options.data()];
+			}
+			return this->global_seen.options[option - schema.options.data()];
+		};
+
+		auto invalid_option = [&] {
+			auto err = error{errc::invalid_option};
+			err.token = token_number;
+			err.name = token;
+			this->fail(err);
+		};
+
+		auto option_value_error = [&](bool is_command_option, std::string_view name, int value_token, std::string_view value, value_errc reason) {
+			auto err = error{is_command_option ? errc::invalid_command_option_value : errc::invalid_option_value, reason};
+			err.token = token_number;
+			err.value_token = value_token;
+			err.name = name;
+			err.value = value;
+			if (is_command_option) {
+				err.command = state.command->name;
+				err.command_alias = state.command->alias;
+			}
+			this->fail(err);
+		};
+
+		auto is_command_option = false;
+		auto key = token.substr(0, token.find('='));
+		auto entry = state.args_only ? nullptr : find_option(key, is_command_option);
+		auto short_entry = !state.args_only && !entry && token.size() > 2 && token[0] == '-' && token[1] != '-'
+			? find_option(token.substr(0, 2), is_command_option) : nullptr;
+
+		if (token == "--"sv) {
+			state.args_only = true;
+		} else if (!state.args_only && token == "--help"sv) {
+			auto err = error{errc::help_requested};
+			err.token = token_number;
+			if (state.command) {
+				err.command = state.command->name;
+				err.command_alias = state.command->alias;
+			}
+			this->fail(err);
+		} else if (entry) {
+			auto& option = *entry->option;
+			auto& seen = option_seen(entry->option, is_command_option);
+			if (key.size() == token.size()) {
+				if (entry->negated) {
+					this->mark(seen);
+				} else if (option.is_flag) {
+					step.extent = next;
+					if (next < this->tokens.size() && is_valid_flag_value(this->tokens[next])) {
+						next++;
+					}
+					this->mark(seen);
+				} else if (option.bulk_fun) {
+					auto end = next;
+					while (end < this->tokens.size() && !this->tokens[end].starts_with('-') && end - next < option.max_values) {
+						end++;
+					}
+					step.extent = end;
+					if (end - next < option.min_values) {
+						step.awaits_value = end == this->tokens.size();
+						option_value_error(is_command_option, token, static_cast<int>(end == next ? index : end - 1) + 1, ""sv, value_errc::not_enough_values);
+					} else {
+						this->mark(seen);
+					}
+					next = end;
+				} else {
+					step.extent = next;
+					if (next < this->tokens.size() && !this->tokens[next].starts_with('-')) {
+						next++;
+						this->mark(seen);
+					} else {
+						step.awaits_value = true;
+						option_value_error(is_command_option, token, token_number, ""sv, value_errc::empty);
+					}
+				}
+			} else if (entry->negated) {
+				invalid_option();
+			} else {
+				auto value = token.substr(key.size() + 1);
+				if (option.is_flag && !is_valid_flag_value(value)) {
+					option_value_error(is_command_option, key, token_number, value, value_errc::not_flag_value);
+				} else {
+					this->mark(seen);
+				}
+			}
+		} else if (short_entry && !short_entry->negated) {
+			auto& option = *short_entry->option;
+			if (!option.is_flag) {
+				this->mark(option_seen(short_entry->option, is_command_option));
+			} else {
+				auto is_short_grouped = std::all_of(std::begin(token) + 1, std::end(token), [&](char c) {
+					char name[] = {'-', c};
+					auto grouped = false;
+					auto entry = find_option(std::string_view{name, 2}, grouped);
+					return entry && !entry->negated && entry->option->is_flag;
+				});
+				if (is_short_grouped) {
+					for (auto c = std::begin(token) + 1; c != std::end(token); c++) {
+						char name[] = {'-', *c};
+						auto grouped = false;
+						auto entry = find_option(std::string_view{name, 2}, grouped);
+						this->mark(option_seen(entry->option, grouped));
+					}
+				} else if (is_valid_flag_value(token.substr(2))) {
+					this->mark(option_seen(short_entry->option, is_command_option));
+				} else {
+					invalid_option();
+				}
+			}
+		} else if (!state.args_only && token.starts_with('-')) {
+			invalid_option();
+		} else {
+			auto matched = false;
+			if (!state.args_only && !state.command) {
+				auto begin = std::begin(this->tokens) + index;
+				auto inspected = std::size_t{0};
+				for (auto& c : schema.commands) {
+					auto words = std::max(command_words(c.name, begin, std::end(this->tokens), inspected),
+						command_words(c.alias, begin, std::end(this->tokens), inspected));
+					if (words > 0) {
+						state.command_index = static_cast<std::size_t>(&c - schema.commands.data());
+						state.command = &this->index_command(state.command_index);
+						next = index + words;
+						matched = true;
+						break;
+					}
+				}
+				step.extent = std::max(step.extent, index + inspected - std::min<std::size_t>(inspected, 1));
+			}
+
+			if (!matched) {
+				auto& command_seen = this->command_seen[command_index];
+				if (state.command && state.command->args.size() > state.command_arg_index) {
+					this->mark(command_seen.args[state.command_arg_index++]);
+				} else if (state.command && state.command->rest_args.parse_fun) {
+					this->mark(command_seen.rest);
+				} else if (schema.args.size() > state.arg_index) {
+					this->mark(this->global_seen.args[state.arg_index++]);
+				} else if (schema.rest_args.parse_fun) {
+					this->mark(this->global_seen.rest);
+				} else {
+					auto err = error{errc::unexpected_arg};
+					err.token = token_number;
+					err.value_token = token_number;
+					err.value = token;
+					this->fail(err);
+				}
+			}
+		}
+
+		step.end = next;
+		return next;
+	}
+
+	ARGS_INLINE error repl::find_missing_target() const {
+		auto& schema = *this->schema;
+		if (schema.command_required_f && !this->state.command) {
+			return error{errc::missing_command};
+		}
+
+		auto missing_option = find_missing(schema.options, this->global_seen.options);
+		if (missing_option != std::end(schema.options)) {
+			auto err = error{errc::missing_option};
+			err.option = &*missing_option;
+			return err;
+		}
+
+		auto missing_arg = find_missing(schema.args, this->global_seen.args);
+		if (missing_arg != std::end(schema.args)) {
+			auto err = error{errc::missing_arg};
+			err.name = missing_arg->name;
+			return err;
+		}
+
+		if (schema.rest_args.parse_fun && schema.rest_args.required && !this->global_seen.rest) {
+			auto err = error{errc::missing_arg};
+			err.name = schema.rest_args.name;
+			return err;
+		}
+
+		if (auto c = this->state.command) {
+			auto& seen = this->command_seen[this->state.command_index];
+			auto missing_command_option = find_missing(c->options, seen.options);
+			if (missing_command_option != std::end(c->options)) {
+				auto err = error{errc::missing_command_option};
+				err.command = c->name;
+				err.command_alias = c->alias;
+				err.option = &*missing_command_option;
+				return err;
+			}
+
+			auto missing_command_arg = find_missing(c->args, seen.args);
+			if (missing_command_arg != std::end(c->args)) {
+				auto err = error{errc::missing_command_arg};
+				err.command = c->name;
+				err.command_alias = c->alias;
+				err.name = missing_command_arg->name;
+				return err;
+			}
+
+			if (c->rest_args.parse_fun && c->rest_args.required && !seen.rest) {
+				auto err = error{errc::missing_command_arg};
+				err.command = c->name;
+				err.command_alias = c->alias;
+				err.name = c->rest_args.name;
+				return err;
+			}
+		}
+
+		return {};
+	}
+
+	ARGS_INLINE void repl::complete() {
+		this->completion_names.clear();
+		auto word = std::string_view{};
+		auto state = this->state;
+		if (!this->line.empty() && !is_line_space(this->line.back()) && !this->tokens.empty()) {
+			auto& last = this->steps.back();
+			if (last.begin != this->tokens.size() - 1) {
+				return;
+			}
+			word = this->tokens.back();
+			state = last.state;
+		} else if (!this->steps.empty() && this->steps.back().awaits_value) {
+			return;
+		}
+
+		if (state.args_only) {
+			return;
+		}
+		auto add = [&](const repl_name& entry) {
+			this->completion_names.push_back(entry.name);
+		};
+		if (word.starts_with('-')) {
+			if (state.command) {
+				this->command_option_names[state.command_index].with_prefix(word, add);
+			}
+			this->global_names.with_prefix(word, add);
+		} else if (!state.command) {
+			this->command_names.with_prefix(word, add);
+		}
+	}
+#endif
+}
+#endif
+
+#ifdef __cpp_lib_expected
+ARGS_EXPORT namespace args {
+	struct batch_status {
+		std::size_t commands = 0;
+		std::size_t failed = 0;
+
+		int exit_code() const {
+			return this->failed > 0 ? 1 : 0;
+		}
+	};
+}
+
+namespace args::detail {
+	template<typename Values>
+	std::optional<std::string> run_batch_command(const args::parser& schema, args::parse_context& context, const args::argv_view& command) {
+		auto run = [&] {
+			if constexpr (std::is_void<Values>::value) {
+				return schema.try_parse(context, command.argc, command.argv);
+			} else {
+				auto values = Values{};
+				return schema.try_parse(context, values, command.argc, command.argv);
+			}
+		};
+#ifdef __cpp_exceptions
+		try {
+#endif
+			auto result = run();
+			if (result) {
+				return std::nullopt;
+			}
+			auto& err = result.error();
+			if (err.code == errc::help_requested) {
+				write_text(err.command.empty() ? schema.format_help() : schema.format_command_help(std::string{err.command}));
+				return std::nullopt;
+			}
+			return err.message();
+#ifdef __cpp_exceptions
+		} catch (const std::exception& e) {
+			return std::string{e.what()};
+		}
+#endif
+	}
+
+	template<typename Values>
+	args::batch_status run_batch_commands(const args::parser& schema, std::span<const args::argv_view> commands,
+			std::span<const std::size_t> numbers, std::size_t threads_count) {
+
+		threads_count = std::is_void<Values>::value ? 1 : std::max<std::size_t>(1, std::min(threads_count, commands.size()));
+		auto next = std::atomic<std::size_t>{0};
+		auto failed = std::atomic<std::size_t>{0};
+
+#ifdef __cpp_exceptions
+		auto failures = std::vector<std::exception_ptr>(threads_count);
+#endif
+		auto work = [&](std::size_t worker) {
+			auto context = args::parse_context{};
+			auto process = [&] {
+				for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < commands.size(); i = next.fetch_add(1, std::memory_order_relaxed)) {
+					if (auto message = run_batch_command<Values>(schema, context, commands[i])) {
+						failed.fetch_add(1, std::memory_order_relaxed);
+						std::cerr << std::to_string(numbers[i]) + ": "s + *message + "\n"s << std::flush;
+					}
+				}
+			};
+#ifdef __cpp_exceptions
+			try {
+				process();
+			} catch (...) {
+				failures[worker] = std::current_exception();
+			}
+#else
+			process();
+#endif
+		};
+
+		auto threads = std::vector<std::thread>{};
+		threads.reserve(threads_count - 1);
+		for (std::size_t t = 1; t < threads_count; t++) {
+			threads.emplace_back(work, t);
+		}
+		work(0);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+#ifdef __cpp_exceptions
+		for (auto& failure : failures) {
+			if (failure) {
+				std::rethrow_exception(failure);
+			}
+		}
+#endif
+		return {commands.size(), failed.load()};
+	}
+
+	template<typename Values>
+	args::batch_status run_batch_words(const args::parser& schema, std::vector<const char*>& words,
+			const std::vector<std::size_t>& starts, const std::vector<std::size_t>& numbers, std::size_t threads_count) {
+
+		auto commands = std::vector<args::argv_view>{};
+		commands.reserve(starts.size());
+		for (std::size_t i = 0; i < starts.size(); i++) {
+			auto end = i + 1 < starts.size() ? starts[i + 1] : words.size();
+			commands.push_back({static_cast<int>(end - starts[i]), words.data() + starts[i]});
+		}
+		return run_batch_commands<Values>(schema, commands, numbers, threads_count);
+	}
+}
+
+ARGS_EXPORT namespace args {
+	template<typename Values = void>
+	batch_status run_batch(const parser& schema, int argc, const char** argv,
+			std::size_t threads_count = std::thread::hardware_concurrency()) {
+
+		auto words = std::vector<const char*>{};
+		auto starts = std::vector<std::size_t>{};
+		auto numbers = std::vector<std::size_t>{};
+		auto number = std::size_t{0};
+		auto begin = std::min(argc, 1);
+		for (auto arg = begin; arg <= argc; arg++) {
+			if (arg < argc && argv[arg] != ";;"sv) {
+				continue;
+			}
+			number++;
+			if (arg > begin) {
+				starts.push_back(words.size());
+				numbers.push_back(number);
+				words.push_back(argc > 0 ? argv[0] : "");
+				words.insert(std::end(words), argv + begin, argv + arg);
+			}
+			begin = arg + 1;
+		}
+		return run_batch_words<Values>(schema, words, starts, numbers, threads_count);
+	}
+
+	template<typename Values = void>
+	batch_status run_batch(const parser& schema, std::istream& input,
+			std::size_t threads_count = std::thread::hardware_concurrency()) {
+
+		auto lines_words = std::deque<std::string>{};
+		auto words = std::vector<const char*>{};
+		auto starts = std::vector<std::size_t>{};
+		auto numbers = std::vector<std::size_t>{};
+		auto line = std::string{};
+		for (std::size_t number = 1; std::getline(input, line); number++) {
+			auto begin = lines_words.size();
+			for (std::size_t offset = 0; ; ) {
+				while (offset < line.size() && is_line_space(line[offset])) {
+					offset++;
+				}
+				if (offset == line.size()) {
+					break;
+				}
+				offset = read_word(line, offset, lines_words.emplace_back());
+			}
+			if (lines_words.size() > begin) {
+				starts.push_back(words.size());
+				numbers.push_back(number);
+				words.push_back("");
+				for (auto word = begin; word < lines_words.size(); word++) {
+					words.push_back(lines_words[word].c_str());
+				}
+			}
+		}
+		return run_batch_words<Values>(schema, words, starts, numbers, threads_count);
+	}
+}
+#endif
+
+#ifdef ARGS_UNIX_SOCKETS
+namespace args::detail {
+	inline constexpr int forwarded_fds_count = 3;
+	inline int serve_signal_fd = -1;
+
+#ifdef MSG_NOSIGNAL
+	inline constexpr int send_flags = MSG_NOSIGNAL;
+#else
+	inline constexpr int send_flags = 0;
+#endif
+
+	inline bool write_all(int fd, const void* data, std::size_t size) {
+		auto bytes = static_cast<const char*>(data);
+		while (size > 0) {
+			auto written = ::send(fd, bytes, size, send_flags);
+			if (written < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return false;
+			}
+			bytes += written;
+			size -= written;
+		}
+		return true;
+	}
+
+	inline bool read_all(int fd, void* data, std::size_t size) {
+		auto bytes = static_cast<char*>(data);
+		while (size > 0) {
+			auto received = ::read(fd, bytes, size);
+			if (received < 0 && errno == EINTR) {
+				continue;
+			}
+			if (received <= 0) {
+				return false;
+			}
+			bytes += received;
+			size -= received;
+		}
+		return true;
+	}
+
+	inline void set_cloexec(int fd) {
+		::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+	}
+
+	inline void throw_system_error(const char* what) {
+		throw_exception(std::system_error{errno, std::generic_category(), what});
+	}
+
+	inline sockaddr_un socket_address(std::string_view path) {
+		auto address = sockaddr_un{};
+		address.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(address.sun_path)) {
+			throw_exception(std::runtime_error("Socket path is too long"));
+		}
+		std::copy(std::begin(path), std::end(path), address.sun_path);
+		return address;
+	}
+
+	inline bool send_with_fds(int socket, const void* data, std::size_t size, const int (&fds)[forwarded_fds_count]) {
+		auto iov = iovec{const_cast<void*>(data), size};
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+		auto message = msghdr{};
+		message.msg_iov = &iov;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+		auto header = CMSG_FIRSTHDR(&message);
+		header->cmsg_level = SOL_SOCKET;
+		header->cmsg_type = SCM_RIGHTS;
+		header->cmsg_len = CMSG_LEN(sizeof(fds));
+		std::memcpy(CMSG_DATA(header), fds, sizeof(fds));
+		return ::sendmsg(socket, &message, send_flags) == static_cast<ssize_t>(size);
+	}
+
+	inline bool receive_with_fds(int socket, void* data, std::size_t size, int (&fds)[forwarded_fds_count]) {
+		auto iov = iovec{data, size};
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+		auto message = msghdr{};
+		message.msg_iov = &iov;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+		if (::recvmsg(socket, &message, 0) != static_cast<ssize_t>(size)) {
+			return false;
+		}
+		auto header = CMSG_FIRSTHDR(&message);
+		if (!header || header->cmsg_type != SCM_RIGHTS || header->cmsg_len != CMSG_LEN(sizeof(fds))) {
+			return false;
+		}
+		std::memcpy(fds, CMSG_DATA(header), sizeof(fds));
+		return true;
+	}
+
+	inline std::string current_directory() {
+		auto path = std::string(256, '\0');
+		while (!::getcwd(path.data(), path.size())) {
+			if (errno != ERANGE) {
+				return "/"s;
+			}
+			path.resize(path.size() * 2);
+		}
+		path.resize(std::strlen(path.c_str()));
+		return path;
+	}
+
+	[[noreturn]] inline void serve_invocation(const args::parser& schema, int connection) {
+		auto size = std::uint32_t{0};
+		int fds[forwarded_fds_count] = {};
+		if (!receive_with_fds(connection, &size, sizeof(size), fds)) {
+			::_exit(255);
+		}
+		auto payload = std::string(size, '\0');
+		if (!read_all(connection, payload.data(), payload.size())) {
+			::_exit(255);
+		}
+		::close(connection);
+		for (auto fd = 0; fd < forwarded_fds_count; fd++) {
+			::dup2(fds[fd], fd);
+			::close(fds[fd]);
+		}
+
+		std::uint32_t counts[2] = {};
+		std::memcpy(counts, payload.data(), sizeof(counts));
+		auto strings = std::vector<char*>{};
+		for (auto pos = sizeof(counts); pos < payload.size(); pos = payload.find('\0', pos) + 1) {
+			strings.push_back(payload.data() + pos);
+		}
+		if (strings.size() != counts[0] + counts[1] + 1) {
+			::_exit(255);
+		}
+		auto env = std::vector<char*>(std::begin(strings) + counts[0], std::end(strings) - 1);
+		env.push_back(nullptr);
+		environ = env.data();
+		if (::chdir(strings.back()) < 0) {
+			::_exit(255);
+		}
+
+		auto status = 0;
+		auto context = args::parse_context{};
+		auto argv = const_cast<const char**>(strings.data());
+#ifdef __cpp_exceptions
+		try {
+#endif
+			auto err = schema.parse_internal(context, static_cast<int>(counts[0]), argv);
+			if (err.code == errc::help_requested) {
+				schema.write_help(err);
+			} else if (err) {
+#ifdef ARGS_EXTERNAL_COMMANDS
+				schema.exec_external(context, err, static_cast<int>(counts[0]), argv);
+#endif
+				std::cerr << err.message() << std::endl;
+				status = 1;
+			}
+#ifdef __cpp_exceptions
+		} catch (const std::exception& e) {
+			std::cerr << e.what() << std::endl;
+			status = 1;
+		}
+#endif
+		std::cout.flush();
+		std::cerr.flush();
+		std::fflush(stdout);
+		std::fflush(stderr);
+		::_exit(status);
+	}
+}
+
+ARGS_EXPORT namespace args {
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE void serve(const parser& schema, std::string_view socket_path) {
+		auto address = socket_address(socket_path);
+		auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener < 0) {
+			throw_system_error("socket");
+		}
+		set_cloexec(listener);
+		::unlink(address.sun_path);
+		if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+				|| ::listen(listener, SOMAXCONN) < 0) {
+			throw_system_error("bind");
+		}
+
+		int signal_pipe[2] = {};
+		if (::pipe(signal_pipe) < 0) {
+			throw_system_error("pipe");
+		}
+		for (auto fd : signal_pipe) {
+			set_cloexec(fd);
+			::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+		}
+		serve_signal_fd = signal_pipe[1];
+		struct sigaction child_action = {};
+		child_action.sa_handler = [](int) {
+			auto saved_errno = errno;
+			auto byte = char{0};
+			[[maybe_unused]] auto written = ::write(serve_signal_fd, &byte, 1);
+			errno = saved_errno;
+		};
+		child_action.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+		::sigaction(SIGCHLD, &child_action, nullptr);
+
+		auto connections = std::map<pid_t, int>{};
+		pollfd fds[2] = {{listener, POLLIN, 0}, {signal_pipe[0], POLLIN, 0}};
+		while (true) {
+			if (::poll(fds, 2, -1) < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw_system_error("poll");
+			}
+
+			if (fds[1].revents & POLLIN) {
+				char buffer[64];
+				while (::read(signal_pipe[0], buffer, sizeof(buffer)) > 0) {}
+				auto status = 0;
+				auto pid = pid_t{};
+				while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0) {
+					auto connection = connections.find(pid);
+					if (connection == std::end(connections)) {
+						continue;
+					}
+					auto code = static_cast<std::int32_t>(WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+					write_all(connection->second, &code, sizeof(code));
+					::close(connection->second);
+					connections.erase(connection);
+				}
+			}
+
+			if (fds[0].revents & POLLIN) {
+				auto connection = ::accept(listener, nullptr, nullptr);
+				if (connection < 0) {
+					continue;
+				}
+				set_cloexec(connection);
+				auto pid = ::fork();
+				if (pid == 0) {
+					::signal(SIGCHLD, SIG_DFL);
+					::close(listener);
+					::close(signal_pipe[0]);
+					::close(signal_pipe[1]);
+					serve_invocation(schema, connection);
+				}
+				if (pid < 0) {
+					::close(connection);
+					continue;
+				}
+				connections[pid] = connection;
+			}
+		}
+	}
+
+	ARGS_INLINE int forward(std::string_view socket_path, int argc, const char** argv) {
+		auto address = socket_address(socket_path);
+		auto connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (connection < 0) {
+			return -1;
+		}
+		if (::connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+			::close(connection);
+			return -1;
+		}
+
+		auto env_count = std::uint32_t{0};
+		while (environ[env_count]) {
+			env_count++;
+		}
+		std::uint32_t counts[2] = {static_cast<std::uint32_t>(argc), env_count};
+		auto payload = std::string(reinterpret_cast<const char*>(counts), sizeof(counts));
+		for (auto i = 0; i < argc; i++) {
+			payload.append(argv[i]).push_back('\0');
+		}
+		for (std::uint32_t i = 0; i < env_count; i++) {
+			payload.append(environ[i]).push_back('\0');
+		}
+		payload.append(current_directory()).push_back('\0');
+
+		auto size = static_cast<std::uint32_t>(payload.size());
+		auto code = std::int32_t{-1};
+		int fds[forwarded_fds_count] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+		if (send_with_fds(connection, &size, sizeof(size), fds)
+				&& write_all(connection, payload.data(), payload.size())
+				&& !read_all(connection, &code, sizeof(code))) {
+			code = 255;
+		}
+		::close(connection);
+		return code;
+	}
+#else
+	void serve(const parser& schema, std::string_view socket_path);
+
+	int forward(std::string_view socket_path, int argc, const char** argv);
+#endif
+}
+#endif
+
+#ifdef ARGS_EXTERNAL_COMMANDS
+namespace args::detail {
+	inline std::string modification_stamp(const std::string& path) {
+		struct stat status;
+		if (::stat(path.c_str(), &status) != 0) {
+			return ""s;
+		}
+#ifdef __APPLE__
+		auto& time = status.st_mtimespec;
+#else
+		auto& time = status.st_mtim;
+#endif
+		return std::to_string(time.tv_sec) + "." + std::to_string(time.tv_nsec);
+	}
+
+	inline bool read_file(const std::string& path, std::string& content) {
+		auto file = std::fopen(path.c_str(), "rb");
+		if (!file) {
+			return false;
+		}
+		char buffer[4096];
+		for (auto size = std::fread(buffer, 1, sizeof(buffer), file); size > 0; size = std::fread(buffer, 1, sizeof(buffer), file)) {
+			content.append(buffer, size);
+		}
+		std::fclose(file);
+		return true;
+	}
+
+	inline void write_file(const std::string& path, std::string_view content) {
+		auto temporary = path + "." + std::to_string(::getpid());
+		auto file = std::fopen(temporary.c_str(), "wb");
+		if (!file) {
+			return;
+		}
+		auto written = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+		if (std::fclose(file) == 0 && written && std::rename(temporary.c_str(), path.c_str()) == 0) {
+			return;
+		}
+		std::remove(temporary.c_str());
+	}
+
+	inline std::string external_index_header(std::string_view prefix, std::string_view path) {
+		auto header = std::string{prefix} + "\t" + std::string{path};
+		while (!path.empty()) {
+			auto end = std::min(path.find(':'), path.size());
+			header += "\t" + modification_stamp(std::string{path.substr(0, end)});
+			path.remove_prefix(std::min(end + 1, path.size()));
+		}
+		return header;
+	}
+
+	inline std::string find_external_commands(std::string_view prefix, std::string_view path) {
+		auto index = ""s;
+		auto names = std::vector<std::string_view>{};
+		while (!path.empty()) {
+			auto end = std::min(path.find(':'), path.size());
+			auto directory = std::string{path.substr(0, end)};
+			path.remove_prefix(std::min(end + 1, path.size()));
+			if (directory.empty()) {
+				continue;
+			}
+			auto dir = ::opendir(directory.c_str());
+			if (!dir) {
+				continue;
+			}
+			while (auto entry = ::readdir(dir)) {
+				auto file = std::string_view{entry->d_name};
+				if (!file.starts_with(prefix) || file.size() == prefix.size() || file.find_first_of("\t\n") != std::string_view::npos) {
+					continue;
+				}
+				auto executable = directory + "/" + std::string{file};
+				struct stat status;
+				if (::stat(executable.c_str(), &status) != 0 || !S_ISREG(status.st_mode) || ::access(executable.c_str(), X_OK) != 0) {
+					continue;
+				}
+				index += "\n" + std::string{file.substr(prefix.size())} + "\t" + executable;
+			}
+			::closedir(dir);
+		}
+		return index;
+	}
+
+	struct string_hash {
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view value) const {
+			return std::hash<std::string_view>{}(value);
+		}
+	};
+
+	struct external_index {
+		std::string prefix = ""s;
+		std::string cache_path = ""s;
+		std::string path = ""s;
+		std::string header = ""s;
+		std::string cache_stamp = ""s;
+		std::unordered_map<std::string, std::string, string_hash, std::equal_to<>> executables = {};
+
+		void load(std::string_view content) {
+			this->executables.clear();
+			for (auto line_end = content.find('\n'); line_end != std::string_view::npos; line_end = content.find('\n')) {
+				content.remove_prefix(line_end + 1);
+				auto line = content.substr(0, content.find('\n'));
+				auto tab = line.find('\t');
+				if (tab != std::string_view::npos) {
+					this->executables.emplace(line.substr(0, tab), line.substr(tab + 1));
+				}
+			}
+		}
+	};
+
+	inline std::mutex external_index_mutex;
+	inline external_index cached_external_index = {};
+}
+
+ARGS_EXPORT namespace args {
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE std::string find_external_command(std::string_view prefix, const std::string& cache_path, std::string_view name) {
+		auto path_variable = std::getenv("PATH");
+		auto path = std::string_view{path_variable ? path_variable : ""};
+		auto lock = std::lock_guard{external_index_mutex};
+		auto& index = cached_external_index;
+		auto loaded = index.prefix == prefix && index.cache_path == cache_path && index.path == path
+			&& index.cache_stamp == modification_stamp(cache_path);
+		if (loaded) {
+			auto found = index.executables.find(name);
+			if (found != std::end(index.executables)) {
+				return found->second;
+			}
+		}
+		auto header = external_index_header(prefix, path);
+		if (!loaded || index.header != header) {
+			auto content = ""s;
+			if (!read_file(cache_path, content) || !content.starts_with(header) || (content.size() > header.size() && content[header.size()] != '\n')) {
+				content = header + find_external_commands(prefix, path) + "\n";
+				write_file(cache_path, content);
+			}
+			index.prefix = prefix;
+			index.cache_path = cache_path;
+			index.path = path;
+			index.header = header;
+			index.cache_stamp = modification_stamp(cache_path);
+			index.load(content);
+		}
+		auto found = index.executables.find(name);
+		return found != std::end(index.executables) ? found->second : ""s;
+	}
+#else
+	std::string find_external_command(std::string_view prefix, const std::string& cache_path, std::string_view name);
+#endif
+}
+
+namespace args {
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE void parser::exec_external(const parse_context& context, const error& err, int argc, const char** argv) const {
+		if (this->external_prefix.empty() || err.code != errc::unexpected_arg || context.matched_command || err.token >= argc) {
+			return;
+		}
+#ifdef ARGS_RESPONSE_FILES
+		if (!context.response_files.files.empty()) {
+			return;
+		}
+#endif
+#ifdef ARGS_ARGUMENT_STREAMS
+		if (!context.nul_args.sources.empty()) {
+			return;
+		}
+#endif
+		for (auto i = 1; i < err.token; i++) {
+			if (argv[i] == "--"sv) {
+				return;
+			}
+		}
+		auto executable = find_external_command(this->external_prefix, this->external_cache, argv[err.token]);
+		if (executable.empty()) {
+			return;
+		}
+		std::cout.flush();
+		std::fflush(nullptr);
+		auto arguments = std::vector<char*>{};
+		for (auto i = err.token; i < argc; i++) {
+			arguments.push_back(const_cast<char*>(argv[i]));
+		}
+		arguments.push_back(nullptr);
+		::execv(executable.c_str(), arguments.data());
+		throw_exception(std::system_error{errno, std::generic_category(), "Can't run \"" + executable + "\""});
+	}
+#endif
+}
+#endif
+
+#ifdef ARGS_PLUGINS
+namespace args::detail {
+	inline constexpr auto plugins_manifest_header = "args-plugins"sv;
+
+	inline bool is_manifest_field(std::string_view field) {
+		return field.find_first_of("\t\n") == std::string_view::npos;
+	}
+
+	inline bool read_plugins_manifest(std::string_view content, std::string_view header, std::vector<args::plugin_info>& plugins) {
+		auto line_end = content.find('\n');
+		if (line_end == std::string_view::npos || content.substr(0, line_end) != header) {
+			return false;
+		}
+		content.remove_prefix(line_end + 1);
+		while (!content.empty()) {
+			line_end = std::min(content.find('\n'), content.size());
+			auto line = content.substr(0, line_end);
+			content.remove_prefix(std::min(line_end + 1, content.size()));
+			std::string_view fields[4];
+			for (auto& field : fields) {
+				auto tab = std::min(line.find('\t'), line.size());
+				field = line.substr(0, tab);
+				line.remove_prefix(std::min(tab + 1, line.size()));
+			}
+			if (fields[0].empty() || fields[3].empty()) {
+				return false;
+			}
+			plugins.push_back({std::string{fields[0]}, std::string{fields[1]}, std::string{fields[2]}, std::string{fields[3]}});
+		}
+		return true;
+	}
+
+	inline void write_plugins_manifest(const std::string& path, std::string_view header, const std::vector<args::plugin_info>& plugins) {
+		auto content = std::string{header} + "\n";
+		for (auto& plugin : plugins) {
+			content += plugin.name + "\t" + plugin.alias + "\t" + plugin.description + "\t" + plugin.library + "\n";
+		}
+		write_file(path, content);
+	}
+
+	inline std::vector<args::plugin_info> find_plugins(const std::string& directory) {
+		auto plugins = std::vector<args::plugin_info>{};
+		auto dir = ::opendir(directory.c_str());
+		if (!dir) {
+			return plugins;
+		}
+		auto libraries = std::vector<std::string>{};
+		while (auto entry = ::readdir(dir)) {
+			auto name = std::string_view{entry->d_name};
+			if (name.ends_with(".so") || name.ends_with(".dylib")) {
+				libraries.push_back(directory + "/" + std::string{name});
+			}
+		}
+		::closedir(dir);
+		std::sort(std::begin(libraries), std::end(libraries));
+
+		for (auto& library : libraries) {
+			auto handle = ::dlopen(library.c_str(), RTLD_LAZY | RTLD_LOCAL);
+			if (!handle) {
+				continue;
+			}
+			if (auto info = reinterpret_cast<void (*)(args::plugin_info&)>(::dlsym(handle, "args_plugin_info"))) {
+				auto plugin = args::plugin_info{};
+				info(plugin);
+				plugin.library = library;
+				if (!plugin.name.empty() && is_manifest_field(plugin.name) && is_manifest_field(plugin.alias)
+						&& is_manifest_field(plugin.description) && is_manifest_field(plugin.library)) {
+					plugins.push_back(std::move(plugin));
+				}
+			}
+			::dlclose(handle);
+		}
+		return plugins;
+	}
+
+	inline void load_plugin(const std::string& library, command_internal& command) {
+		auto handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (!handle) {
+			throw_exception(std::runtime_error("Can't load plugin \""s + library + "\": " + ::dlerror()));
+		}
+		auto register_command = reinterpret_cast<void (*)(command_internal&)>(::dlsym(handle, "args_plugin_register"));
+		if (!register_command) {
+			throw_exception(std::runtime_error("Plugin \""s + library + "\" has no args_plugin_register"));
+		}
+		register_command(command);
+	}
+}
+
+namespace args {
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE parser& parser::plugins(const std::vector<args::plugin_info>& plugins) {
+		for (auto& plugin : plugins) {
+			this->command(plugin.name, plugin.alias, plugin.description, [library = plugin.library](command_internal& command) {
+				load_plugin(library, command);
+			});
+		}
+		return *this;
+	}
+#endif
+}
+
+ARGS_EXPORT namespace args {
+#ifdef ARGS_HEADER_DEFINITIONS
+	ARGS_INLINE std::vector<plugin_info> scan_plugins(const std::string& directory, const std::string& cache_path) {
+		auto header = std::string{plugins_manifest_header} + "\t" + directory + "\t" + modification_stamp(directory);
+		auto plugins = std::vector<plugin_info>{};
+		auto content = ""s;
+		if (read_file(cache_path, content) && read_plugins_manifest(content, header, plugins)) {
+			return plugins;
+		}
+		plugins = find_plugins(directory);
+		write_plugins_manifest(cache_path, header, plugins);
+		return plugins;
+	}
+#else
+	std::vector<plugin_info> scan_plugins(const std::string& directory, const std::string& cache_path);
+#endif
+}
+#endif
+
+#ifdef ARGS_LIBRARY
+namespace args {
+	ARGS_EXTERN template parse_fun_t value_parser(bool*);
+	ARGS_EXTERN template parse_fun_t value_parser(char*);
+	ARGS_EXTERN template parse_fun_t value_parser(int*);
+	ARGS_EXTERN template parse_fun_t value_parser(unsigned*);
+	ARGS_EXTERN template parse_fun_t value_parser(long*);
+	ARGS_EXTERN template parse_fun_t value_parser(unsigned long*);
+	ARGS_EXTERN template parse_fun_t value_parser(long long*);
+	ARGS_EXTERN template parse_fun_t value_parser(unsigned long long*);
+	ARGS_EXTERN template parse_fun_t value_parser(float*);
+	ARGS_EXTERN template parse_fun_t value_parser(double*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::string*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::vector<int>*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::vector<long>*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::vector<double>*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::vector<std::string>*);
+	ARGS_EXTERN template parse_fun_t value_parser(std::map<std::string, std::string>*);
+}
+#endif
+
+ARGS_EXPORT namespace args {
+	template<std::size_t N>
+	struct fixed_string {
+		char data[N] = {};
+
+		constexpr fixed_string(const char (&str)[N]) {
+			std::copy_n(str, N, this->data);
+		}
+
+		constexpr std::string_view view() const {
+			return {this->data, N - 1};
+		}
+	};
+}
+
+namespace args::detail {
+	enum class descriptor_kind {
+		name,
+		description,
+		option,
+		arg,
+		rest
+	};
+
+	struct no_value {};
+
+	struct option_names {
+		std::string_view short_name = {};
+		std::string_view long_name = {};
+		std::string_view non_conventional = {};
+		std::string_view description = {};
+		bool valid = true;
+	};
+
+	constexpr bool is_short_name(std::string_view name) {
+		return name.size() == 2 && name[0] == '-' && name != "--";
+	}
+
+	constexpr bool is_long_name(std::string_view name) {
+		return name.size() > 2 && name.starts_with("--");
+	}
+
+	template<std::size_t N>
+	constexpr option_names make_option_names(const std::array<std::string_view, N>& strings) {
+		auto names = option_names{};
+		auto set_name = [&](std::string_view name) {
+			auto& slot = is_short_name(name) ? names.short_name
+				: is_long_name(name) ? names.long_name
+				: names.non_conventional;
+			names.valid = names.valid && slot.empty() && !name.empty() && name != "--" && name != "--help";
+			slot = name;
+		};
+		set_name(strings[0]);
+		if constexpr (N >= 2) {
+			if (N == 3 || is_short_name(strings[1]) || is_long_name(strings[1])) {
+				set_name(strings[1]);
+			} else {
+				names.description = strings[1];
+			}
+		}
+		if constexpr (N == 3) {
+			names.description = strings[2];
+		}
+		return names;
+	}
+
+	inline constexpr std::size_t static_label_width = 16;
+	inline constexpr std::string_view static_indentation = "      ";
+
+	struct text_writer {
+		char* data = nullptr;
+		std::size_t size = 0;
+
+		constexpr void operator()(std::string_view str) {
+			if (this->data) {
+				std::copy(std::begin(str), std::end(str), this->data + this->size);
+			}
+			this->size += str.size();
+		}
+	};
+
+	template<typename Writer>
+	struct static_text {
+		static constexpr auto size = [] {
+			auto w = text_writer{};
+			Writer::write(w);
+			return w.size;
+		}();
+
+		static constexpr auto buffer = [] {
+			auto buffer = std::array<char, size + 1>{};
+			auto w = text_writer{buffer.data()};
+			Writer::write(w);
+			return buffer;
+		}();
+
+		static constexpr auto view = std::string_view{buffer.data(), size};
+	};
+
+	template<typename D>
+	struct option_print_name_writer {
+		static constexpr void write(text_writer& w) {
+			auto first = true;
+			for (auto name : {D::names.short_name, D::names.long_name, D::names.non_conventional}) {
+				if (!name.empty()) {
+					if (!first) {
+						w(", ");
+					}
+					first = false;
+					w(name);
+				}
+			}
+		}
+	};
+
+	template<typename... D>
+	struct static_schema {
+		static constexpr auto size = sizeof...(D);
+		static constexpr auto kinds = std::array<descriptor_kind, size>{D::kind...};
+
+		template<std::size_t I>
+		using descriptor = std::tuple_element_t<I, std::tuple<D...>>;
+
+		static constexpr auto positions = [] {
+			auto positions = std::array<int, size>{};
+			auto position = 0;
+			for (std::size_t i = 0; i < size; i++) {
+				positions[i] = kinds[i] == descriptor_kind::arg ? position++ : -1;
+			}
+			return positions;
+		}();
+
+		static constexpr auto args_count = std::count(std::begin(kinds), std::end(kinds), descriptor_kind::arg);
+		static constexpr auto rests_count = std::count(std::begin(kinds), std::end(kinds), descriptor_kind::rest);
+
+		static constexpr auto rest_index = [] {
+			auto it = std::find(std::begin(kinds), std::end(kinds), descriptor_kind::rest);
+			return static_cast<std::size_t>(std::distance(std::begin(kinds), it));
+		}();
+
+		template<typename T>
+		static constexpr option_names names_of() {
+			if constexpr (T::kind == descriptor_kind::option) {
+				return T::names;
+			} else {
+				return {};
+			}
+		}
+
+		template<typename T>
+		static constexpr std::string_view arg_name_of() {
+			if constexpr (T::kind == descriptor_kind::arg || T::kind == descriptor_kind::rest) {
+				return T::name;
+			} else {
+				return {};
+			}
+		}
+
+		template<typename T>
+		static constexpr bool is_flag_of() {
+			if constexpr (T::kind == descriptor_kind::option) {
+				return T::is_flag;
+			} else {
+				return false;
+			}
+		}
+
+		static constexpr auto options = std::array<option_names, size>{names_of<D>()...};
+		static constexpr auto arg_names = std::array<std::string_view, size>{arg_name_of<D>()...};
+		static constexpr auto flags = std::array<bool, size>{is_flag_of<D>()...};
+
+		static constexpr auto names = [] {
+			auto names = std::array<std::string_view, size * 4>{};
+			for (std::size_t i = 0; i < size; i++) {
+				names[i * 4] = options[i].short_name;
+				names[i * 4 + 1] = options[i].long_name;
+				names[i * 4 + 2] = options[i].non_conventional;
+				names[i * 4 + 3] = arg_names[i];
+			}
+			return names;
+		}();
+
+		static constexpr bool valid_names = std::all_of(std::begin(options), std::end(options), [](auto& o) {
+			return o.valid;
+		});
+
+		static constexpr bool unique_names = [] {
+			for (std::size_t i = 0; i < names.size(); i++) {
+				for (std::size_t j = i + 1; j < names.size(); j++) {
+					if (!names[i].empty() && names[i] == names[j]) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}();
+
+		static constexpr bool unambiguous_names = [] {
+			for (std::size_t i = 0; i < size; i++) {
+				for (std::size_t j = 0; j < size; j++) {
+					auto& a = options[i];
+					auto& b = options[j];
+					if (i != j && !a.short_name.empty() && b.non_conventional.starts_with(a.short_name)) {
+						return false;
+					}
+					if (flags[i] && !a.long_name.empty() && b.long_name.starts_with("--no-")
+							&& b.long_name.substr(5) == a.long_name.substr(2)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}();
+
+		static constexpr std::size_t index_of(std::string_view name) {
+			for (std::size_t i = 0; i < size; i++) {
+				if (!name.empty() && (options[i].short_name == name || options[i].long_name == name
+						|| options[i].non_conventional == name || arg_names[i] == name)) {
+					return i;
+				}
+			}
+			return size;
+		}
+
+		template<typename T>
+		static constexpr void write_usage_option(text_writer& w, bool& has_optional_options) {
+			if constexpr (T::kind == descriptor_kind::option) {
+				if (T::required) {
+					w(" ");
+					w(!T::names.long_name.empty() ? T::names.long_name
+						: !T::names.short_name.empty() ? T::names.short_name
+						: T::names.non_conventional);
+					w("=value");
+				} else {
+					has_optional_options = true;
+				}
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_usage_arg(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::arg) {
+				w(T::required ? " <" : " [<");
+				w(T::name.empty() ? "ARG" : T::name);
+				w(T::required ? ">" : ">]");
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_usage_rest(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::rest) {
+				w(T::required ? " <" : " [<");
+				w(T::name.empty() ? "REST" : T::name);
+				w(T::required ? "...>" : "...>]");
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_name(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::name) {
+				w(T::name);
+			}
+		}
+
+		static constexpr void write_usage(text_writer& w) {
+			auto has_name = ((D::kind == descriptor_kind::name) || ...);
+			w("  ");
+			if (has_name) {
+				(write_name<D>(w), ...);
+			} else {
+				w("CMD");
+			}
+			auto has_optional_options = false;
+			(write_usage_option<D>(w, has_optional_options), ...);
+			if (has_optional_options) {
+				w(" [options]");
+			}
+			(write_usage_arg<D>(w), ...);
+			(write_usage_rest<D>(w), ...);
+			w("\n");
+		}
+
+		struct usage_writer {
+			static constexpr void write(text_writer& w) {
+				write_usage(w);
+			}
+		};
+
+		static constexpr auto has_name = ((D::kind == descriptor_kind::name) || ...);
+		static constexpr auto has_description = ((D::kind == descriptor_kind::description) || ...);
+		static constexpr auto options_count = std::count(std::begin(kinds), std::end(kinds), descriptor_kind::option);
+
+		template<typename T>
+		static constexpr void write_description(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::description) {
+				w(T::description);
+			}
+		}
+
+		static constexpr void write_label(text_writer& w, std::string_view label, std::string_view wrap_prefix) {
+			w(static_indentation);
+			w(label);
+			if (label.size() <= static_label_width) {
+				for (auto i = label.size(); i < static_label_width; i++) {
+					w(" ");
+				}
+				w("  ");
+			} else {
+				w("\n");
+				w(wrap_prefix);
+				w(static_indentation);
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_arg_description(text_writer& w, bool& first) {
+			if constexpr (T::kind == descriptor_kind::arg) {
+				if (!first) {
+					w("\n");
+				}
+				first = false;
+				write_label(w, T::name, "     ");
+				w(T::description);
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_rest_description(text_writer& w, bool& first) {
+			if constexpr (T::kind == descriptor_kind::rest) {
+				if (!first) {
+					w("\n");
+				}
+				write_label(w, T::name, static_indentation);
+				w(T::description);
+			}
+		}
+
+		template<typename T>
+		static constexpr void write_option_description(text_writer& w, bool& first) {
+			if constexpr (T::kind == descriptor_kind::option) {
+				if (!first) {
+					w("\n");
+				}
+				first = false;
+				write_label(w, T::print_name, static_indentation);
+				if (T::required) {
+					w("Required! ");
+				}
+				w(T::names.description);
+			}
 		}
 
-		template<typename T, typename F>
-		parser& arg(args::required_t, const std::string& name, F handler) {
-			this->args.emplace_back(args::required, name, create_parse_fun<T>(handler));
-			return *this;
-		}
+		static constexpr void write_help(text_writer& w) {
+			w("USAGE\n");
+			write_usage(w);
 
-		template<typename T, typename F>
-		parser& arg(args::required_t, const std::string& name, const std::string& description, F handler) {
-			this->args.emplace_back(args::required, name, description, create_parse_fun<T>(handler));
-			return *this;
+			if (has_description) {
+				w("\nDESCRIPTION\n");
+				w(static_indentation);
+				(write_description<D>(w), ...);
+				w("\n");
+			}
+
+			if (args_count > 0 || rests_count > 0) {
+				w("\nARGUMENTS\n");
+				auto first = true;
+				(write_arg_description<D>(w, first), ...);
+				(write_rest_description<D>(w, first), ...);
+				w("\n");
+			}
+
+			if (options_count > 0) {
+				w("\nOPTIONS\n");
+				auto first = true;
+				(write_option_description<D>(w, first), ...);
+				w("\n");
+			}
 		}
 
 		template<typename T>
-		parser& rest(T* destination) {
-			this->rest_args = {create_parse_fun(destination)};
-			return *this;
+		static constexpr void write_man_item(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::arg || T::kind == descriptor_kind::rest) {
+				w(".TP\n.B ");
+				write_roff(w, !T::name.empty() ? T::name : T::kind == descriptor_kind::arg ? "ARG" : "REST");
+				w("\n");
+				write_roff(w, T::description);
+				w("\n");
+			} else if constexpr (T::kind == descriptor_kind::option) {
+				w(".TP\n.B ");
+				write_roff(w, T::print_name);
+				w("\n");
+				if (T::required) {
+					w("Required! ");
+				}
+				write_roff(w, T::names.description);
+				w("\n");
+			}
 		}
 
 		template<typename T>
-		parser& rest(const std::string& name, T* destination) {
-			this->rest_args = {name, create_parse_fun(destination)};
-			return *this;
+		static constexpr void write_man_name(text_writer& w, bool upper) {
+			if constexpr (T::kind == descriptor_kind::name) {
+				write_roff(w, T::name, upper);
+			}
 		}
 
 		template<typename T>
-		parser& rest(const std::string& name, const std::string& description, T* destination) {
-			this->rest_args = {name, description, create_parse_fun(destination)};
-			return *this;
+		static constexpr void write_man_description(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::description) {
+				write_roff(w, T::description);
+			}
 		}
 
 		template<typename T>
-		parser& rest(args::required_t, const std::string& name, T* destination) {
-			this->rest_args = {args::required, name, create_parse_fun(destination)};
-			return *this;
+		static constexpr void write_man_arg(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::arg || T::kind == descriptor_kind::rest) {
+				write_man_item<T>(w);
+			}
 		}
 
 		template<typename T>
-		parser& rest(args::required_t, const std::string& name, const std::string& description, T* destination) {
-			this->rest_args = {args::required, name, description, create_parse_fun(destination)};
-			return *this;
+		static constexpr void write_man_option(text_writer& w) {
+			if constexpr (T::kind == descriptor_kind::option) {
+				write_man_item<T>(w);
+			}
 		}
 
-		template<typename T, typename F>
-		parser& rest(F handler) {
-			this->rest_args = {create_parse_fun<T>(handler)};
-			return *this;
-		}
+		static constexpr void write_man(text_writer& w) {
+			w(".TH ");
+			if (has_name) {
+				(write_man_name<D>(w, true), ...);
+			} else {
+				w("CMD");
+			}
+			w(" 1\n.SH NAME\n");
+			if (has_name) {
+				(write_man_name<D>(w, false), ...);
+			} else {
+				w("CMD");
+			}
+			if (has_description) {
+				w(" \\- ");
+				(write_man_description<D>(w), ...);
+			}
 
-		template<typename T, typename F>
-		parser& rest(const std::string& name, F handler) {
-			this->rest_args = {name, create_parse_fun<T>(handler)};
-			return *this;
-		}
+			w("\n.SH SYNOPSIS\n.nf\n");
+			write_roff(w, static_text<usage_writer>::view);
+			w(".fi\n");
 
-		template<typename T, typename F>
-		parser& rest(const std::string& name, const std::string& description, F handler) {
-			this->rest_args = {name, description, create_parse_fun<T>(handler)};
-			return *this;
-		}
+			if (has_description) {
+				w(".SH DESCRIPTION\n");
+				(write_man_description<D>(w), ...);
+				w("\n");
+			}
 
-		template<typename T, typename F>
-		parser& rest(args::required_t, const std::string& name, F handler) {
-			this->rest_args = {args::required, name, create_parse_fun<T>(handler)};
-			return *this;
-		}
+			if (args_count > 0 || rests_count > 0) {
+				w(".SH ARGUMENTS\n");
+				(write_man_arg<D>(w), ...);
+			}
 
-		template<typename T, typename F>
-		parser& rest(args::required_t, const std::string& name, const std::string& description, F handler) {
-			this->rest_args = {args::required, name, description, create_parse_fun<T>(handler)};
-			return *this;
+			if (options_count > 0) {
+				w(".SH OPTIONS\n");
+				(write_man_option<D>(w), ...);
+			}
 		}
 
-		parser& option(args::option option) {
-			this->options.push_back(option);
-			return *this;
-		}
+		struct help_writer {
+			static constexpr void write(text_writer& w) {
+				write_help(w);
+			}
+		};
 
-		template<typename T>
-		parser& option(const std::string& name, T* destination) {
-			this->options.emplace_back(name, destination);
-			return *this;
-		}
+		struct man_writer {
+			static constexpr void write(text_writer& w) {
+				write_man(w);
+			}
+		};
+	};
+}
 
-		template<typename T>
-		parser& option(args::required_t, const std::string& name, T* destination) {
-			this->options.emplace_back(args::required, name, destination);
-			return *this;
-		}
+ARGS_EXPORT namespace args {
+	template<typename T, fixed_string... Strings>
+	struct static_option {
+		static_assert(sizeof...(Strings) >= 1 && sizeof...(Strings) <= 3,
+			"static_option takes name, [long name], [description]");
 
-		template<typename T, typename F>
-		parser& option(const std::string& name, F handler) {
-			this->options.emplace_back(name, "", "", "",
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+		using type = T;
+		static constexpr auto kind = descriptor_kind::option;
+		static constexpr auto required = false;
+		static constexpr auto is_flag = std::is_same<T, bool>::value;
+		static constexpr auto names = make_option_names(std::array<std::string_view, sizeof...(Strings)>{Strings.view()...});
+		static constexpr auto print_name = static_text<option_print_name_writer<static_option>>::view;
 
-		template<typename T, typename F>
-		parser& option(args::required_t, const std::string& name, F handler) {
-			this->options.emplace_back(name, "", "", "",
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+		static_assert(names.valid, "static_option names must be distinct short, long or non conventional names");
+	};
 
-		template<typename T>
-		parser& option(const std::string& short_name, const std::string& long_name_or_desc, T* destination) {
-			this->options.emplace_back(short_name, long_name_or_desc, destination);
-			return *this;
-		}
+	template<typename T, fixed_string Name = "", fixed_string Description = "">
+	struct static_arg {
+		using type = T;
+		static constexpr auto kind = descriptor_kind::arg;
+		static constexpr auto required = false;
+		static constexpr auto name = Name.view();
+		static constexpr auto description = Description.view();
+	};
 
-		template<typename T>
-		parser& option(const std::string& short_name, const std::string& long_name, const std::string& description, T* destination) {
-			this->options.emplace_back(short_name, long_name, description, destination);
-			return *this;
-		}
+	template<typename T, fixed_string Name = "", fixed_string Description = "">
+	struct static_rest {
+		using type = T;
+		static constexpr auto kind = descriptor_kind::rest;
+		static constexpr auto required = false;
+		static constexpr auto name = Name.view();
+		static constexpr auto description = Description.view();
+	};
 
-		template<typename T>
-		parser& option(args::required_t, const std::string& short_name, const std::string& long_name_or_desc, T* destination) {
-			this->options.emplace_back(args::required, short_name, long_name_or_desc, destination);
-			return *this;
-		}
+	template<fixed_string Name>
+	struct static_name {
+		using type = no_value;
+		static constexpr auto kind = descriptor_kind::name;
+		static constexpr auto name = Name.view();
+	};
 
-		template<typename T>
-		parser& option(args::required_t, const std::string& short_name, const std::string& long_name, const std::string& description, T* destination) {
-			this->options.emplace_back(args::required, short_name, long_name, description, destination);
-			return *this;
-		}
+	template<fixed_string Description>
+	struct static_description {
+		using type = no_value;
+		static constexpr auto kind = descriptor_kind::description;
+		static constexpr auto description = Description.view();
+	};
 
-		template<typename T, typename F>
-		parser& option(const std::string& short_name, const std::string& long_name_or_desc, F handler) {
-			this->options.emplace_back("", short_name, long_name_or_desc, "",
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+	template<typename D>
+	struct static_required : D {
+		static constexpr auto required = true;
+	};
 
-		template<typename T, typename F>
-		parser& option(const std::string& short_name, const std::string& long_name, const std::string& description, F handler) {
-			this->options.emplace_back("", short_name, long_name, description,
-					false, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+	template<typename... D>
+	class static_parser {
+		private:
 
-		template<typename T, typename F>
-		parser& option(args::required_t, const std::string& short_name, const std::string& long_name_or_desc, F handler) {
-			this->options.emplace_back("", short_name, long_name_or_desc, "",
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+		using schema = static_schema<D...>;
 
-		template<typename T, typename F>
-		parser& option(args::required_t, const std::string& short_name, const std::string& long_name, const std::string& description, F handler) {
-			this->options.emplace_back("", short_name, long_name, description,
-					true, std::is_same<T, bool>::value, create_parse_fun<T>(handler));
-			return *this;
-		}
+		static_assert(schema::valid_names, "Invalid option name");
+		static_assert(schema::unique_names, "Duplicate option or argument name");
+		static_assert(schema::unambiguous_names, "Ambiguous option names");
+		static_assert(schema::rests_count <= 1, "Only one static_rest is allowed");
 
-		command_internal& command(const std::string& name) {
-			return this->commands.emplace_back(name);
-		}
+		std::tuple<typename D::type...> values = {};
+		std::array<bool, sizeof...(D)> exists_f = {};
 
-		command_internal& command(const std::string& name, const std::string& alias_or_desc) {
-			return this->commands.emplace_back(name, alias_or_desc);
+		template<std::size_t I>
+		value_errc parse_value_of(std::string_view value) {
+			auto err = parse_value(value, &std::get<I>(this->values));
+			if (err == value_errc::none) {
+				this->exists_f[I] = true;
+			}
+			return err;
 		}
 
-		command_internal& command(const std::string& name, const std::string& alias, const std::string& description) {
-			return this->commands.emplace_back(name, alias, description);
+		template<std::size_t I>
+		value_errc parse_value_at(std::size_t index, std::string_view value) {
+			if constexpr (schema::kinds[I] == descriptor_kind::option
+					|| schema::kinds[I] == descriptor_kind::arg
+					|| schema::kinds[I] == descriptor_kind::rest) {
+				if (index == I) {
+					return this->parse_value_of<I>(value);
+				}
+			}
+			return value_errc::none;
 		}
 
-		command_internal& command(const std::string& name, bool* destination) {
-			return this->commands.emplace_back(name, destination);
+		template<std::size_t... I>
+		value_errc parse_value_at(std::index_sequence<I...>, std::size_t index, std::string_view value) {
+			auto err = value_errc::none;
+			((err = index == I ? this->parse_value_at<I>(index, value) : err), ...);
+			return err;
 		}
 
-		command_internal& command(const std::string& name, const std::string& alias_or_desc, bool* destination) {
-			return this->commands.emplace_back(name, alias_or_desc, destination);
+		value_errc parse_value_at(std::size_t index, std::string_view value) {
+			return this->parse_value_at(std::index_sequence_for<D...>{}, index, value);
 		}
 
-		command_internal& command(const std::string& name, const std::string& alias, const std::string& description, bool* destination) {
-			return this->commands.emplace_back(name, alias, destination);
+		static std::size_t find_short_flag(char c) {
+			for (std::size_t i = 0; i < schema::size; i++) {
+				auto& name = schema::options[i].short_name;
+				if (schema::flags[i] && name.size() == 2 && name[1] == c) {
+					return i;
+				}
+			}
+			return schema::size;
 		}
 
-		void parse(int argc, const char** argv) {
-			auto args = std::vector<std::string>{};
-			for (auto arg = argv + 1; arg < argv + argc; arg++) {
-				args.emplace_back(*arg);
-			}
-
-			auto command_it = std::end(this->commands);
-			auto is_command_option = false;
-			auto find_option_if = [&](const std::function<bool (args::option& o)>& pred) -> args::option* {
-				if (command_it != std::end(this->commands)) {
-					auto command_option_it = std::find_if(std::begin(command_it->options), std::end(command_it->options), pred);
-					if (command_option_it != std::end(command_it->options)) {
-						is_command_option = true;
-						return &*command_option_it;
-					}
-				}
-				auto global_option_it = std::find_if(std::begin(this->options), std::end(this->options), pred);
-				if (global_option_it != std::end(this->options)) {
-					is_command_option = false;
-					return &*global_option_it;
-				} else {
-					is_command_option = false;
-					return nullptr;
-				}
+		error parse_internal(int argc, const char** argv) {
+			this->reset();
+			auto option_value_error = [&](int token, std::string_view name, int value_token, std::string_view value, value_errc reason) {
+				auto err = error{errc::invalid_option_value, reason};
+				err.token = token;
+				err.value_token = value_token;
+				err.name = name;
+				err.value = value;
+				return err;
 			};
 
 			auto args_only = false;
 			auto arg_index = 0;
-			auto command_arg_index = 0;
-			for (auto arg = std::begin(args); arg != std::end(args); arg++) {
-				if (*arg == "--"s) {
+			for (auto i = 1; i < argc; i++) {
+				auto arg = std::string_view{argv[i]};
+				if (arg == "--") {
 					args_only = true;
 					continue;
 				}
 
 				if (!args_only) {
-					if (*arg == "--help"s) {
-						if (this->help_fun) {
-							this->help_fun();
-							return;
-						} else {
-							if (command_it != std::end(this->commands)) {
-								std::cout << this->format_command_help(*command_it);
-							} else {
-								std::cout << this->format_help();
-							}
-							std::exit(0);
-						}
-					}
-
-					auto option_it = find_option_if([&](auto& o) {
-						return (!o.short_name.empty() && arg->starts_with(o.short_name))
-							|| (!o.long_name.empty() && arg->starts_with(o.long_name))
-							|| (!o.non_conventional.empty() && arg->starts_with(o.non_conventional));
-					});
-
-					if (!option_it && arg->starts_with("--no-")) {
-						auto name = "--"s + arg->substr(5);
-						option_it = find_option_if([&](auto& o) {
-							return !o.long_name.empty() && o.long_name == name;
-						});
-
-						if (!option_it || !option_it->is_flag) {
-							option_it = nullptr;
-						}
-					}
-
-					if (!option_it && arg->starts_with('-')) {
-						throw invalid_option{*arg};
+					if (arg == "--help") {
+						auto err = error{errc::help_requested};
+						err.token = i;
+						return err;
 					}
 
-					if (option_it) {
-						if (*arg == option_it->short_name || *arg == option_it->long_name
-								|| *arg == option_it->non_conventional) {
-
-							if (option_it->is_flag) {
-								auto next = std::next(arg);
-								if (next != std::end(args) && is_valid_flag_value(*next)) {
-									try {
-										option_it->parse(*next);
-									} catch (const std::runtime_error& err) {
-										if (is_command_option) {
-											throw invalid_command_option_value{command_print_name(*command_it), *arg, *next, err.what()};
-										} else {
-											throw invalid_option_value{*arg, *next, err.what()};
+					auto matched = false;
+					for (std::size_t o = 0; o < schema::size && !matched; o++) {
+						auto& names = schema::options[o];
+						for (auto name : {names.short_name, names.long_name, names.non_conventional}) {
+							if (name.empty() || !arg.starts_with(name)) {
+								continue;
+							}
+							if (arg.size() == name.size()) {
+								matched = true;
+								auto next = i + 1 < argc ? std::string_view{argv[i + 1]} : std::string_view{};
+								if (schema::flags[o]) {
+									if (i + 1 < argc && is_valid_flag_value(next)) {
+										auto reason = this->parse_value_at(o, next);
+										if (reason != value_errc::none) {
+											return option_value_error(i, arg, i + 1, next, reason);
 										}
+										i++;
+									} else {
+										this->parse_value_at(o, "1");
 									}
-									arg++;
-								} else {
-									option_it->parse("1");
-								}
-							} else {
-								auto next = std::next(arg);
-								if (next != std::end(args) && !next->starts_with("-")) {
-									try {
-										option_it->parse(*next);
-									} catch (const std::runtime_error& err) {
-										if (is_command_option) {
-											throw invalid_command_option_value{command_print_name(*command_it), *arg, *next, err.what()};
-										} else {
-											throw invalid_option_value{*arg, *next, err.what()};
-										}
+								} else if (i + 1 < argc && !next.starts_with("-")) {
+									auto reason = this->parse_value_at(o, next);
+									if (reason != value_errc::none) {
+										return option_value_error(i, arg, i + 1, next, reason);
 									}
-									arg++;
+									i++;
 								} else {
-									auto name = *arg;
-									if (is_command_option) {
-										throw invalid_command_option_value{command_print_name(*command_it), name, "", "Value is empty."};
-									} else {
-										throw invalid_option_value{name, "", "Value is empty."};
-									}
+									return option_value_error(i, arg, i, {}, value_errc::empty);
 								}
-							}
-						} else if ((!option_it->short_name.empty() && arg->starts_with(option_it->short_name + "="))
-								|| (!option_it->long_name.empty() && arg->starts_with(option_it->long_name + "="))
-								|| (!option_it->non_conventional.empty() && arg->starts_with(option_it->non_conventional + "="))) {
-
-							auto value = arg->substr(arg->find("=") + 1);
-							try {
-								option_it->parse(value);
-							} catch (const std::runtime_error& err) {
-								auto name = arg->substr(0, arg->find("="));
-								if (is_command_option) {
-									throw invalid_command_option_value{command_print_name(*command_it), name, value, err.what()};
-								} else {
-									throw invalid_option_value{name, value, err.what()};
+							} else if (arg[name.size()] == '=') {
+								matched = true;
+								auto value = arg.substr(name.size() + 1);
+								auto reason = this->parse_value_at(o, value);
+								if (reason != value_errc::none) {
+									return option_value_error(i, name, i, value, reason);
 								}
 							}
-						} else if (!option_it->short_name.empty() && arg->starts_with(option_it->short_name)
-								&& option_it->is_flag) {
-
-							auto is_short_grouped = std::all_of(std::begin(*arg) + 1, std::end(*arg), [&](auto& c) {
-								auto name = "-"s + c;
-								auto option_it = find_option_if([&](auto& o) {
-									return o.short_name == name;
-								});
-								return option_it && option_it->is_flag;
-							});
-							if (is_short_grouped) {
-								std::for_each(std::begin(*arg) + 1, std::end(*arg), [&](auto& c) {
-									auto name = "-"s + c;
-									auto option_it = find_option_if([&](auto& o) {
-										return o.short_name == name;
-									});
-									option_it->parse("1");
-								});
-							} else if (is_valid_flag_value(arg->substr(2))) {
-								option_it->parse(arg->substr(2));
-							} else {
-								throw invalid_option{*arg};
-							}
-						} else if (!option_it->short_name.empty() && arg->starts_with(option_it->short_name)
-								&& !option_it->is_flag) {
-
-							auto value = arg->substr(2);
-							try {
-								option_it->parse(value);
-							} catch (const std::runtime_error& err) {
-								auto name = arg->substr(0, 2);
-								if (is_command_option) {
-									throw invalid_command_option_value{command_print_name(*command_it), name, value, err.what()};
-								} else {
-									throw invalid_option_value{name, value, err.what()};
-								}
+							if (matched) {
+								break;
 							}
-						} else if (arg->starts_with("--no-")) {
-							option_it->parse("0");
 						}
-
-						continue;
+						if (!matched && schema::flags[o] && !names.long_name.empty() && arg.starts_with("--no-")
+								&& arg.substr(5) == names.long_name.substr(2)) {
+							matched = true;
+							this->parse_value_at(o, "0");
+						}
 					}
-				}
 
-				if (!args_only && command_it == std::end(this->commands)) {
-					auto prefix_it = std::find_if(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
-						return arg->starts_with(c.name) || arg->starts_with(c.alias);
-					});
-					if (prefix_it != std::end(this->commands)) {
-						auto possible_command = *arg;
-						auto next = arg;
-						while (possible_command.size() <= prefix_it->name.size()
-								|| possible_command.size() <= prefix_it->alias.size()) {
-							if (prefix_it->name == possible_command || prefix_it->alias == possible_command) {
-								command_it = prefix_it;
-								arg = next;
-								break;
-							}
-							next = std::next(next);
-							if (next != std::end(args) && !next->starts_with("-")) {
-								possible_command += " "s + *next;
+					for (std::size_t o = 0; o < schema::size && !matched; o++) {
+						auto& short_name = schema::options[o].short_name;
+						if (short_name.empty() || !arg.starts_with(short_name)) {
+							continue;
+						}
+						matched = true;
+						if (schema::flags[o]) {
+							auto is_short_grouped = std::all_of(std::begin(arg) + 1, std::end(arg), [&](char c) {
+								return find_short_flag(c) != schema::size;
+							});
+							if (is_short_grouped) {
+								for (auto c : arg.substr(1)) {
+									this->parse_value_at(find_short_flag(c), "1");
+								}
+							} else if (is_valid_flag_value(arg.substr(2))) {
+								this->parse_value_at(o, arg.substr(2));
 							} else {
-								break;
+								auto err = error{errc::invalid_option};
+								err.token = i;
+								err.name = arg;
+								return err;
+							}
+						} else {
+							auto reason = this->parse_value_at(o, arg.substr(2));
+							if (reason != value_errc::none) {
+								return option_value_error(i, short_name, i, arg.substr(2), reason);
 							}
 						}
 					}
 
-					if (command_it != std::end(this->commands)) {
-						if (command_it->destination) {
-							*command_it->destination = true;
-						}
+					if (matched) {
 						continue;
 					}
-				}
 
-				if (command_it != std::end(this->commands)) {
-					if (command_it->args.size() > command_arg_index) {
-						try {
-							command_it->args[command_arg_index].parse(*arg);
-						} catch (const std::runtime_error& err) {
-							auto name = command_it->args[command_arg_index].name;
-							throw invalid_command_arg_value{command_print_name(command_it->name), name, *arg, err.what()};
-						}
-						command_arg_index++;
-						continue;
-					} else if (command_it->rest_args.parse_fun) {
-						try {
-							command_it->rest_args.parse(*arg);
-						} catch (const std::runtime_error& err) {
-							auto name = command_it->rest_args.name;
-							throw invalid_command_arg_value{command_print_name(command_it->name), name, *arg, err.what()};
-						}
-						continue;
+					if (arg.starts_with('-')) {
+						auto err = error{errc::invalid_option};
+						err.token = i;
+						err.name = arg;
+						return err;
 					}
 				}
 
-				if (this->args.size() > arg_index) {
-					try {
-						this->args[arg_index].parse(*arg);
-					} catch (const std::runtime_error& err) {
-						auto name = this->args[arg_index].name;
-						throw invalid_arg_value{name, *arg, err.what()};
-					}
+				auto index = schema::size;
+				if (arg_index < schema::args_count) {
+					index = std::distance(std::begin(schema::positions),
+						std::find(std::begin(schema::positions), std::end(schema::positions), arg_index));
 					arg_index++;
-				} else if (this->rest_args.parse_fun) {
-					try {
-						this->rest_args.parse(*arg);
-					} catch (const std::runtime_error& err) {
-						auto name = this->rest_args.name;
-						throw invalid_arg_value{name, *arg, err.what()};
-					}
-				} else {
-					throw unexpected_arg{*arg};
-				}
-			}
-
-			if (this->command_required_f && command_it == std::end(this->commands)) {
-					throw missing_command{};
-			}
-
-			auto missing_option_it = std::find_if(std::begin(this->options), std::end(this->options), [](auto& o) {
-				return o.required && !o.exists;
-			});
-
-			if (missing_option_it != std::end(this->options)) {
-				throw missing_option{option_print_name(*missing_option_it)};
-			}
-
-			auto missing_arg_it = std::find_if(std::begin(this->args), std::end(this->args), [](auto& a) {
-				return a.required && !a.exists;
-			});
-
-			if (missing_arg_it != std::end(this->args)) {
-				throw missing_arg{missing_arg_it->name};
-			}
-
-			if (this->rest_args.parse_fun && this->rest_args.required && !this->rest_args.exists) {
-				throw missing_arg{this->rest_args.name};
-			}
-
-			if (command_it != std::end(this->commands)) {
-				auto missing_command_option_it = std::find_if(std::begin(command_it->options), std::end(command_it->options), [](auto& o) {
-					return o.required && !o.exists;
-				});
-
-				if (missing_command_option_it != std::end(command_it->options)) {
-					throw missing_command_option{command_print_name(*command_it), option_print_name(*missing_command_option_it)};
+				} else if (schema::rests_count > 0) {
+					index = schema::rest_index;
 				}
 
-				if (command_it->action_fun) {
-					command_it->action_fun();
+				if (index == schema::size) {
+					auto err = error{errc::unexpected_arg};
+					err.token = i;
+					err.value_token = i;
+					err.value = arg;
+					return err;
 				}
 
-				auto missing_command_arg_it = std::find_if(std::begin(command_it->args), std::end(command_it->args), [](auto& a) {
-					return a.required && !a.exists;
-				});
-
-				if (missing_command_arg_it != std::end(command_it->args)) {
-					throw missing_command_arg{command_print_name(*command_it), missing_command_arg_it->name};
-				}
-
-				if (command_it->rest_args.parse_fun && command_it->rest_args.required && !command_it->rest_args.exists) {
-					throw missing_command_arg{command_print_name(*command_it), command_it->rest_args.name};
+				auto reason = this->parse_value_at(index, arg);
+				if (reason != value_errc::none) {
+					auto err = error{errc::invalid_arg_value, reason};
+					err.token = i;
+					err.value_token = i;
+					err.name = schema::arg_names[index];
+					err.value = arg;
+					return err;
 				}
 			}
+
+			return this->check_required(std::index_sequence_for<D...>{});
 		}
 
-		std::string format_usage(const std::string& indentation = default_indentation) {
-			auto ss = std::stringstream{};
-			auto name = this->cmd_name.empty() ? "CMD" : this->cmd_name;
+		template<std::size_t... I>
+		error check_required(std::index_sequence<I...>) {
+			auto err = error{};
+			(this->check_required<typename schema::template descriptor<I>, I>(err), ...);
+			return err;
+		}
 
-			if (this->command_required_f) {
-				auto first = true;
-				std::for_each(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
-					if (!first) {
-						ss << "\n";
-					}
-					first = false;
-					ss << indentation << name;
-					ss << format_usage_options(this->options);
-					ss << format_usage_args(this->args, this->rest_args);
-					ss << " " << command_print_name(c, "|"s);
-					ss << format_usage_options(c.options);
-					ss << format_usage_args(c.args, c.rest_args);
-				});
-			} else {
-				ss << "  " << name;
-				ss << format_usage_options(this->options);
-				ss << format_usage_args(this->args, this->rest_args);
-				if (this->commands.size() > 0) {
-					if (this->command_required_f) {
-						ss << " command ...";
+		template<typename T, std::size_t I>
+		void check_required(error& err) {
+			if constexpr (T::kind != descriptor_kind::name && T::kind != descriptor_kind::description) {
+				if (!err && T::required && !this->exists_f[I]) {
+					if constexpr (T::kind == descriptor_kind::option) {
+						err = error{errc::missing_option};
+						err.name = T::print_name;
 					} else {
-						ss << " [command] ...";
+						err = error{errc::missing_arg};
+						err.name = T::name;
 					}
 				}
 			}
-			ss << "\n";
-			return ss.str();
 		}
 
-		std::string format_commands(const std::string& indentation = default_indentation) {
-			auto ss = std::stringstream{};
-			auto first = true;
-			std::for_each(std::begin(this->commands), std::end(this->commands), [&](auto& c) {
-				if (!first) {
-					ss << "\n";
-				}
-				first = false;
-				auto name = command_print_name(c);
-				if (name.size() <= max_label_width) {
-					ss << indentation << std::left << std::setw(max_label_width) << name << std::setw(0);
-					ss << "  ";
-				} else {
-					ss << indentation << name;
-					ss << "\n" << indentation << indentation;
-				}
-
-				if (!c.description.empty()) {
-					ss << c.description;
-				}
-			});
-			ss << "\n";
-			return ss.str();
-		}
-
-		std::string format_command_usage(const std::string& command_name, const std::string& indentation = default_indentation) {
-			auto& c = this->get_command_by_name(command_name);
-			return format_command_usage(c, indentation);
-		}
+		public:
 
-		std::string format_args(const std::string& indentation = default_indentation) {
-			return format_args_description(this->args, this->rest_args, indentation);
-		}
+		static constexpr std::string_view usage = static_text<typename schema::usage_writer>::view;
+		static constexpr std::string_view help = static_text<typename schema::help_writer>::view;
+		static constexpr std::string_view man = static_text<typename schema::man_writer>::view;
 
-		std::string format_command_args(const std::string& command_name, const std::string& indentation = default_indentation) {
-			auto& c = this->get_command_by_name(command_name);
-			return format_args_description(c.args, c.rest_args, indentation);
+		template<fixed_string Name>
+		auto& get() {
+			constexpr auto index = schema::index_of(Name.view());
+			static_assert(index < schema::size, "No option or argument with this name");
+			return std::get<index>(this->values);
 		}
 
-		std::string format_options(const std::string& indentation = default_indentation) {
-			return format_options_description(this->options, indentation);
+		template<fixed_string Name>
+		bool exists() const {
+			constexpr auto index = schema::index_of(Name.view());
+			static_assert(index < schema::size, "No option or argument with this name");
+			return this->exists_f[index];
 		}
 
-		std::string format_command_options(const std::string& command_name, const std::string& indentation = default_indentation) {
-			auto& c = this->get_command_by_name(command_name);
-			return format_options_description(c.options, indentation);
+		static_parser& reset() {
+			this->exists_f = {};
+			return *this;
 		}
 
-		std::string format_help(const std::string& indentation = default_indentation) {
-			auto ss = std::stringstream{};
-			ss << "USAGE\n";
-			ss << this->format_usage(indentation);
-
-			if (!this->cmd_description.empty()) {
-				ss << "\nDESCRIPTION\n";
-				ss << indentation << this->cmd_description << "\n";
-			}
-
-			if (this->args.size() > 0 || this->rest_args.parse_fun) {
-				ss << "\nARGUMENTS\n";
-				ss << this->format_args(indentation);
-			}
-
-			if (this->options.size() > 0) {
-				ss << "\nOPTIONS\n";
-				ss << this->format_options(indentation);
-			}
-
-			if (this->commands.size() > 0) {
-				ss << "\nCOMMANDS\n";
-				ss << this->format_commands(indentation);
+		void parse(int argc, const char** argv) {
+			auto err = this->parse_internal(argc, argv);
+			if (err.code == errc::help_requested) {
+				write_text(static_parser::help);
+				std::exit(0);
+			} else if (err) {
+				raise_error(err);
 			}
-
-			return ss.str();
 		}
 
-		std::string format_command_help(const std::string& command_name, const std::string& indentation = default_indentation) {
-			auto& c = this->get_command_by_name(command_name);
-			return format_command_help(c, indentation);
+#ifdef __cpp_lib_expected
+		std::expected<void, error> try_parse(int argc, const char** argv) {
+			return to_expected(this->parse_internal(argc, argv));
 		}
+#endif
 	};
-
-	void parse(int argc, const char** argv, const args::options& options) {
-		auto p = parser{};
-		for (auto& option : options) {
-			p.option(option);
-		}
-		p.parse(argc, argv);
-	}
 }
 
 #endif
+
+#endif
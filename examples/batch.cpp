@@ -0,0 +1,33 @@
+#include <atomic>
+#include <iostream>
+
+#include "../args.h"
+
+struct operation {
+	int a = 0;
+	int b = 0;
+};
+
+int main(int argc, const char** argv) {
+	auto total = std::atomic<long long>{0};
+	auto p = args::parser{}
+		.name("batch");
+
+	p.command("add", "Add numbers")
+		.arg(args::required, "A", &operation::a)
+		.arg(args::required, "B", &operation::b)
+		.action<operation>([&](operation& op) {
+			total += op.a + op.b;
+		});
+
+	p.command("mul", "Multiply numbers")
+		.arg(args::required, "A", &operation::a)
+		.arg(args::required, "B", &operation::b)
+		.action<operation>([&](operation& op) {
+			total += op.a * op.b;
+		});
+
+	auto status = argc > 1 ? args::run_batch<operation>(p, argc, argv) : args::run_batch<operation>(p, std::cin);
+	std::cout << status.commands << " commands, " << status.failed << " failed, total " << total << std::endl;
+	return status.exit_code();
+}
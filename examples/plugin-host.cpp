@@ -0,0 +1,22 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "../args.h"
+
+int main(int argc, const char** argv) {
+	auto directory = std::getenv("PLUGINS_DIR");
+	auto cache = std::getenv("PLUGINS_CACHE");
+	auto verbose = false;
+	auto p = args::parser{}
+		.name("plugin-host")
+		.option("-v", "--verbose", "Verbose output", &verbose)
+		.plugins(args::scan_plugins(directory ? directory : "examples/plugins", cache ? cache : "/tmp/args-plugins.cache"));
+
+	try {
+		p.parse(argc, argv);
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+}
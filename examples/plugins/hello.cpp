@@ -0,0 +1,13 @@
+#include <iostream>
+#include <string>
+
+#include "../../args.h"
+
+std::string name = "world";
+
+ARGS_PLUGIN("hello", "hi", "Print greeting") {
+	command.option("--name", &name)
+		.action([] {
+			std::cout << "Hello, " << name << "!" << std::endl;
+		});
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "../args.h"
+
+int main(int argc, const char** argv) {
+	auto name = ""s;
+	auto var = ""s;
+	auto p = args::parser{}
+		.name("serve");
+
+	p.command("greet", "Print greeting")
+		.option(args::required, "--name", &name)
+		.action([&]() {
+			std::cout << "Hello, " << name << "!" << std::endl;
+		});
+
+	p.command("env", "Print environment variable")
+		.arg(args::required, "NAME", &var)
+		.action([&]() {
+			auto value = std::getenv(var.c_str());
+			std::cout << var << "=" << (value ? value : "") << std::endl;
+		});
+
+	if (argc == 3 && argv[1] == "--serve"sv) {
+		args::serve(p, argv[2]);
+	}
+
+	if (auto socket = std::getenv("SERVE_SOCKET")) {
+		auto status = args::forward(socket, argc, argv);
+		if (status >= 0) {
+			return status;
+		}
+	}
+
+	try {
+		p.parse(argc, argv);
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,34 @@
+#include <vector>
+#include <iostream>
+
+#include "../args.h"
+
+using cli = args::static_parser<
+	args::static_name<"static-parser">,
+	args::static_description<"Static parser example">,
+	args::static_option<bool, "-b", "--bool", "Bool flag">,
+	args::static_required<args::static_option<int, "-i", "--int", "Int option">>,
+	args::static_option<std::vector<int>, "-v", "Repeated option">,
+	args::static_arg<std::string, "file", "Input file">,
+	args::static_rest<std::vector<std::string>, "rest", "Rest args">
+>;
+
+int main(int argc, const char** argv) {
+	auto p = cli{};
+
+	try {
+		p.parse(argc, argv);
+
+	} catch (const std::runtime_error& err) {
+		std::cout << err.what() << std::endl;
+		std::cout << "USAGE\n" << cli::usage;
+		return 1;
+	}
+
+	std::cout << std::boolalpha;
+	std::cout << "b=" << p.get<"-b">() << std::endl;
+	std::cout << "i=" << p.get<"--int">() << std::endl;
+	std::cout << "v.size()=" << p.get<"-v">().size() << std::endl;
+	std::cout << "file=" << p.get<"file">() << std::endl;
+	std::cout << "rest.size()=" << p.get<"rest">().size() << std::endl;
+}
@@ -0,0 +1,30 @@
+#include <iostream>
+
+#include "../args.h"
+
+int main(int argc, const char** argv) {
+	auto b = false;
+	auto num = 0;
+	auto str = ""s;
+	auto p = args::parser{}
+		.option("--bool", &b)
+		.option(args::required, "--num", &num)
+		.option("--str", &str);
+
+	auto result = p.try_parse(argc, argv);
+	if (!result) {
+		auto& err = result.error();
+		if (err.code == args::errc::help_requested) {
+			std::cout << p.format_help();
+			return 0;
+		}
+		std::cout << err.message() << std::endl;
+		std::cout << ".token=" << err.token << std::endl;
+		return 1;
+	}
+
+	std::cout << std::boolalpha;
+	std::cout << "b=" << b << std::endl;
+	std::cout << "num=" << num << std::endl;
+	std::cout << "str=" << str << std::endl;
+}
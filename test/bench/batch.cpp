@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../args.h"
+
+struct job {
+	int jobs = 0;
+	std::string target = ""s;
+	bool verbose = false;
+	std::vector<std::string> files = {};
+};
+
+int main(int argc, const char** argv) {
+	const auto inputs_count = 1000000;
+	auto cores = static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()));
+	auto max_threads = argc > 1 ? static_cast<std::size_t>(std::stoi(argv[1])) : cores;
+
+	auto p = args::parser{}
+		.option(args::required, "-j", "--jobs", "Number of jobs", &job::jobs)
+		.option("--verbose", &job::verbose);
+	p.command("build", "b", "Build target")
+		.arg(args::required, "TARGET", &job::target)
+		.rest("FILES", &job::files);
+
+	auto jobs = std::vector<std::string>{};
+	for (auto i = 0; i < inputs_count; i++) {
+		jobs.push_back(std::to_string(i % 64));
+	}
+	auto argvs = std::vector<std::array<const char*, 8>>{};
+	for (auto& j : jobs) {
+		argvs.push_back({"make", "-j", j.c_str(), "--verbose", "build", "all", "a.cpp", "b.cpp"});
+	}
+	auto inputs = std::vector<args::argv_view>{};
+	for (auto& a : argvs) {
+		inputs.push_back({static_cast<int>(a.size()), a.data()});
+	}
+
+	std::cout << cores << " cores" << std::endl;
+	for (std::size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+		auto failed = std::atomic<std::size_t>{0};
+		auto start = std::chrono::steady_clock::now();
+		args::parse_batch<job>(p, inputs, [&](std::size_t, std::expected<job, args::error> result) {
+			if (!result) {
+				failed.fetch_add(1, std::memory_order_relaxed);
+			}
+		}, threads_count);
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << threads_count << " threads: " << static_cast<long long>(inputs_count / elapsed) << " argv/s";
+		if (failed) {
+			std::cout << ", " << failed << " failed";
+		}
+		std::cout << std::endl;
+	}
+}
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../args.h"
+
+template<typename F>
+void measure(const char* name, F parse) {
+	auto start = std::chrono::steady_clock::now();
+	auto count = parse();
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << name << ": " << static_cast<long long>(elapsed * 1000) << " ms, " << count << " ids" << std::endl;
+}
+
+int main() {
+	const auto ids_count = 5000000;
+	const auto path = "/tmp/args-bench-ids.u64"s;
+
+	auto ids = std::vector<std::uint64_t>{};
+	auto decimals = std::vector<std::string>{};
+	for (auto i = 0; i < ids_count; i++) {
+		ids.push_back(std::uint64_t{1} << 40 | static_cast<std::uint64_t>(i) * 7919);
+		decimals.push_back(std::to_string(ids.back()));
+	}
+	args::write_binary_array(path, ids);
+
+	auto argv = std::vector<const char*>{"exec"};
+	for (auto& decimal : decimals) {
+		argv.push_back(decimal.c_str());
+	}
+
+	measure("rest(&vector) decimal", [&] {
+		auto values = std::vector<std::uint64_t>{};
+		auto p = args::parser{}
+			.rest("IDS", &values);
+		p.parse(static_cast<int>(argv.size()), argv.data());
+		return values.size();
+	});
+
+	auto binary = "@bin:" + path;
+	const char* binary_argv[] = {"exec", binary.c_str()};
+
+	measure("rest(&vector) @bin", [&] {
+		auto values = std::vector<std::uint64_t>{};
+		auto p = args::parser{}
+			.rest("IDS", &values);
+		p.parse(2, binary_argv);
+		return values.size();
+	});
+
+	measure("binary_array @bin", [&] {
+		auto values = args::binary_array<std::uint64_t>{};
+		auto p = args::parser{}
+			.arg("IDS", &values);
+		p.parse(2, binary_argv);
+		return values.values.size();
+	});
+
+	std::remove(path.c_str());
+}
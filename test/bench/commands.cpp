@@ -0,0 +1,59 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../args.h"
+
+const auto commands_count = 600;
+const auto options_count = 20;
+
+std::vector<std::string> names = {};
+std::vector<std::string> options = {};
+std::vector<int> values(options_count);
+
+template<typename C>
+void add_options(C& command) {
+	for (auto i = 0; i < options_count; i++) {
+		command.option(options[i], "Option description", &values[i]);
+	}
+}
+
+template<typename F>
+void measure(const char* name, F parse) {
+	const auto parses_count = 100;
+	auto start = std::chrono::steady_clock::now();
+	for (auto i = 0; i < parses_count; i++) {
+		parse();
+	}
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << name << ": " << static_cast<long long>(elapsed / parses_count * 1e6) << " us per run" << std::endl;
+}
+
+int main() {
+	for (auto i = 0; i < commands_count; i++) {
+		names.push_back("command-" + std::to_string(i));
+	}
+	for (auto i = 0; i < options_count; i++) {
+		options.push_back("--option-" + std::to_string(i));
+	}
+	const char* argv[] = {"exec", "command-42", "--option-7", "7"};
+
+	measure("eager commands", [&] {
+		auto p = args::parser{};
+		for (auto& name : names) {
+			add_options(p.command(name, "Command description"));
+		}
+		p.parse(std::size(argv), argv);
+	});
+
+	measure("lazy commands", [&] {
+		auto p = args::parser{};
+		for (auto& name : names) {
+			p.command(name, "Command description", [](auto& c) {
+				add_options(c);
+			});
+		}
+		p.parse(std::size(argv), argv);
+	});
+}
@@ -0,0 +1,36 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../args.h"
+
+#define OPTIONS_10 \
+	p.option("-i", "--int", "Int option", &i); \
+	p.option(args::required, "-s", "--str", "String option", &s); \
+	p.option("-b", "Bool option", &b); \
+	p.option("-d", &d); \
+	p.option("-v", "--vec", "Vector option", &v); \
+	p.option<int>("-n", "--num", "Handler option", [&](int value) { i = value; }); \
+	p.option<std::string>(args::required, "-t", [&](const std::string& value) { s = value; }); \
+	p.command("cmd").option("-c", "--cmd", "Command option", &i); \
+	p.command("get", "g").option(args::required, "-g", &s); \
+	p.command("set").option<bool>("-f", [&](bool value) { b = value; });
+
+#define OPTIONS_100 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10 OPTIONS_10
+
+int main(int argc, const char** argv) {
+	auto i = 0;
+	auto s = ""s;
+	auto b = false;
+	auto d = 0.0;
+	auto v = std::vector<int>{};
+
+	auto p = args::parser{};
+	OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100
+	OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100
+	OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100
+	OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100 OPTIONS_100
+	p.parse(argc, argv);
+
+	std::cout << i << s << b << d << v.size() << std::endl;
+}
@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../args.h"
+
+int main() {
+	const auto options_count = 3000;
+	constexpr auto commands_count = 30;
+
+	auto values = std::vector<int>(options_count);
+	bool flags[commands_count] = {};
+	auto key = ""s;
+	auto names = std::vector<std::string>{};
+	for (auto i = 0; i < options_count; i++) {
+		names.push_back("--option-" + std::to_string(i));
+	}
+
+	auto p = args::parser{};
+	for (auto i = 0; i < options_count; i++) {
+		p.option(names[i], &values[i]);
+	}
+	for (auto i = 0; i < commands_count; i++) {
+		p.command("command-" + std::to_string(i))
+			.option("--flag", &flags[i])
+			.arg(args::required, "KEY", &key);
+	}
+
+	auto line = "--option-1 1 --option-2000 2 --option-2999 3 command-17 --flag yes key --option-42 42"s;
+	auto r = args::repl{p};
+	auto total = std::chrono::duration<double>{0};
+	auto slowest = std::chrono::duration<double>{0};
+	for (std::size_t size = 1; size <= line.size(); size++) {
+		auto start = std::chrono::steady_clock::now();
+		r.update(std::string_view{line}.substr(0, size));
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		total += elapsed;
+		slowest = std::max<std::chrono::duration<double>>(slowest, elapsed);
+	}
+
+	std::cout << options_count << " options, " << line.size() << " keystrokes: "
+		<< static_cast<long long>(total.count() / line.size() * 1e6) << " us average, "
+		<< static_cast<long long>(slowest.count() * 1e6) << " us slowest" << std::endl;
+}
@@ -0,0 +1,40 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../args.h"
+
+int main() {
+	const auto paths_count = 2000000;
+	const auto path = "/tmp/args-bench-response"s;
+
+	auto content = "--\n"s;
+	for (auto i = 0; i < paths_count; i++) {
+		content += "src/file-" + std::to_string(i) + ".cpp" + (i % 16 == 0 ? "\n" : " ");
+	}
+	auto file = std::fopen(path.c_str(), "wb");
+	std::fwrite(content.data(), 1, content.size(), file);
+	std::fclose(file);
+
+	auto count = std::size_t{0};
+	auto p = args::parser{}
+		.response_files()
+		.rest_bulk("FILES", [&](std::span<const std::string_view> files) {
+			count += files.size();
+		});
+
+	auto response = "@" + path;
+	const char* argv[] = {"exec", response.c_str()};
+	auto start = std::chrono::steady_clock::now();
+	p.parse(2, argv);
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::remove(path.c_str());
+
+	std::cout << content.size() / 1000000 << " MB, " << count << " tokens: "
+		<< static_cast<long long>(elapsed * 1000) << " ms, "
+		<< static_cast<long long>(content.size() / elapsed / 1000000) << " MB/s" << std::endl;
+}
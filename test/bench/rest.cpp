@@ -0,0 +1,58 @@
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../args.h"
+
+template<typename F>
+void measure(const char* name, F parse) {
+	auto start = std::chrono::steady_clock::now();
+	auto count = parse();
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << name << ": " << static_cast<long long>(elapsed * 1000) << " ms, " << count << " values" << std::endl;
+}
+
+int main() {
+	const auto paths_count = 1000000;
+
+	auto paths = std::vector<std::string>{};
+	for (auto i = 0; i < paths_count; i++) {
+		paths.push_back("src/file-" + std::to_string(i) + ".cpp");
+	}
+	auto argv = std::vector<const char*>{"exec", "--"};
+	for (auto& path : paths) {
+		argv.push_back(path.c_str());
+	}
+	auto argc = static_cast<int>(argv.size());
+
+	measure("rest(&vector)", [&] {
+		auto files = std::vector<std::string>{};
+		auto p = args::parser{}
+			.rest("FILES", &files);
+		p.parse(argc, argv.data());
+		return files.size();
+	});
+
+	measure("rest<T>(lambda)", [&] {
+		auto count = std::size_t{0};
+		auto p = args::parser{}
+			.rest<std::string>("FILES", [&](const std::string&) {
+				count++;
+			});
+		p.parse(argc, argv.data());
+		return count;
+	});
+
+	measure("rest_bulk(lambda)", [&] {
+		auto count = std::size_t{0};
+		auto p = args::parser{}
+			.rest_bulk("FILES", [&](std::span<const std::string_view> files) {
+				count += files.size();
+			});
+		p.parse(argc, argv.data());
+		return count;
+	});
+}
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../args.h"
+
+struct request {
+	int jobs = 0;
+	std::string name = ""s;
+	bool verbose = false;
+	std::vector<std::string> files = {};
+};
+
+int main(int argc, const char** argv) {
+	const auto parses_count = 200000;
+	auto max_threads = argc > 1 ? std::stoi(argv[1]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+	auto p = args::parser{}
+		.option("-j", "--jobs", "Number of jobs", &request::jobs)
+		.option("--verbose", &request::verbose);
+	p.command("get", "g", "Get value")
+		.arg(args::required, "KEY", &request::name)
+		.rest("FILES", &request::files);
+	const auto& schema = p;
+
+	for (auto threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+		auto start = std::chrono::steady_clock::now();
+		auto threads = std::vector<std::thread>{};
+		for (auto t = 0; t < threads_count; t++) {
+			threads.emplace_back([&] {
+				const char* request_argv[] = {"exec", "-j", "8", "--verbose", "get", "key", "a", "b"};
+				auto context = args::parse_context{};
+				auto values = request{};
+				for (auto i = 0; i < parses_count; i++) {
+					values.files.clear();
+					schema.parse(context, values, std::size(request_argv), request_argv);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << threads_count << " threads: "
+			<< static_cast<long long>(parses_count * threads_count / elapsed) << " parses/s" << std::endl;
+	}
+}
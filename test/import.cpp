@@ -0,0 +1,19 @@
+#include "../args.h"
+
+int main(int argc, const char** argv) {
+	auto build = false;
+	auto clean = false;
+	args::parser p;
+	p.name("import");
+	p.command("build", "b", "Build", &build);
+	p.command("clean", &clean);
+
+	const char* fixed[] = {"import", "b"};
+	p.parse(2, fixed);
+	if (!build || clean || p.format_help().empty()) {
+		return 1;
+	}
+	p.reset();
+	p.parse(argc, argv);
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include <string>
+
+#include "../../args.h"
+
+std::string parse_commands(int argc, const char** argv) {
+	auto a = ""s;
+	auto c = false;
+	auto p = args::parser{};
+	p.name("cmd");
+	p.command("get", "g", "Get command")
+		.arg(args::required, "name", &a)
+		.option("-c", "Option C", &c);
+	p.parse(argc, argv);
+	return a + (c ? "c" : "");
+}
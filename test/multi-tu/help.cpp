@@ -0,0 +1,13 @@
+#include <string>
+
+#include "../../args.h"
+
+std::string format_help() {
+	auto b = false;
+	auto p = args::parser{};
+	p.name("cmd")
+		.description("Description")
+		.option("-b", "--bool", "Bool option", &b)
+		.flags();
+	return p.format_help() + p.format_man();
+}
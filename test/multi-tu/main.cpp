@@ -0,0 +1,24 @@
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "../../args.h"
+
+std::string parse_options(int argc, const char** argv);
+std::string parse_commands(int argc, const char** argv);
+std::string format_help();
+
+int main() {
+	const char* options_argv[] = {"exec", "--str", "str", "-v", "1", "-v", "2"};
+	const char* commands_argv[] = {"exec", "get", "name", "-c"};
+
+	auto options = parse_options(std::size(options_argv), options_argv);
+	auto commands = parse_commands(std::size(commands_argv), commands_argv);
+	auto help = format_help();
+
+	if (options != "str2" || commands != "namec" || help.find("--jobs") == std::string::npos) {
+		std::cerr << "multi-tu: unexpected result" << std::endl;
+		return 1;
+	}
+	return 0;
+}
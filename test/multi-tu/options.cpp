@@ -0,0 +1,19 @@
+#include <string>
+#include <vector>
+
+#include "../../args.h"
+
+ARGS_FLAG(int, jobs, {"-j", "--jobs", "Number of jobs"}, 1);
+
+std::string parse_options(int argc, const char** argv) {
+	auto str = ""s;
+	auto v = std::vector<int>{};
+
+	args::options options = {
+		{"-s", "--str", &str},
+		{"-v", &v}
+	};
+
+	args::parse(argc, argv, options);
+	return str + std::to_string(v.size());
+}
@@ -0,0 +1,19 @@
+#include <vector>
+
+#include "../args.h"
+
+int top = 0;
+std::vector<std::string> items = {};
+
+extern "C" int plugin_top() {
+	return top;
+}
+
+extern "C" std::size_t plugin_items() {
+	return items.size();
+}
+
+ARGS_PLUGIN("stats", "st", "Print statistics") {
+	command.option("--top", &top)
+		.rest("ITEMS", &items);
+}
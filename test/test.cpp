@@ -7,6 +7,15 @@
 #include <utility>
 #include <map>
 #include <unordered_map>
+#include <cstdint>
+#include <array>
+#include <optional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <cstdlib>
+#include <new>
 
 #include "../args.h"
 
@@ -77,6 +86,27 @@ std::ostream& operator<<(std::ostream &ss, const std::pair<T1, T2>& p) {
 #include "./ctl.h"
 using namespace ctl;
 
+std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+	allocation_count++;
+	if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+ARGS_FLAG(int, test_jobs, {"-j", "--jobs", "Number of jobs"}, 1);
+ARGS_FLAG(bool, test_verbose, {"--verbose"});
+
 int main() {
 	describe("Options", []{
 		it("short name, -s", []{
@@ -377,6 +407,45 @@ int main() {
 			ctl::expect_equal(rest, {"multi", "word"});
 		});
 
+		it("commands without aliases", []{
+			const char* argv[] = {
+				"./exec",
+				"get"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto list_called = false;
+			auto get_called = false;
+
+			auto p = args::parser{};
+			p.command("list", &list_called);
+			p.command("get", &get_called);
+
+			p.parse(argc, argv);
+
+			ctl::expect_fail(list_called);
+			ctl::expect_ok(get_called);
+		});
+
+		it("matches commands declared after one without alias", []{
+			auto parse = [](std::vector<const char*> argv) {
+				auto build = false;
+				auto clean = false;
+				auto multi = false;
+				auto p = args::parser{};
+				p.command("build", &build);
+				p.command("clean", &clean);
+				p.command("multi word cmd", "mwc", "Multi word command", &multi);
+				p.parse(static_cast<int>(argv.size()), argv.data());
+				return std::vector<bool>{build, clean, multi};
+			};
+
+			ctl::expect_equal(parse({"./exec", "build"}), std::vector<bool>{true, false, false});
+			ctl::expect_equal(parse({"./exec", "clean"}), std::vector<bool>{false, true, false});
+			ctl::expect_equal(parse({"./exec", "multi", "word", "cmd"}), std::vector<bool>{false, false, true});
+			ctl::expect_equal(parse({"./exec", "mwc"}), std::vector<bool>{false, false, true});
+		});
+
 		it("options", []{
 			const char* argv[] = {
 				"./exec",
@@ -2107,5 +2176,2381 @@ int main() {
 			ctl::expect_equal(l, "str"s);
 		});
 	});
-}
 
+	describe("try_parse", []{
+		it("returns value on success", []{
+			const char* argv[] = {
+				"exec",
+				"-s",
+				"--long=str"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto s = false;
+			auto l = ""s;
+			auto p = args::parser{}
+				.option("-s", &s)
+				.option("--long", &l);
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_ok(result.has_value());
+			ctl::expect_equal(s, true);
+			ctl::expect_equal(l, "str"s);
+		});
+
+		it("invalid option value", []{
+			const char* argv[] = {
+				"exec",
+				"-s",
+				"--num",
+				"asd"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto s = false;
+			auto n = 0;
+			auto p = args::parser{}
+				.option("-s", &s)
+				.option("--num", &n);
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			auto& err = result.error();
+			ctl::expect_ok(err.code == args::errc::invalid_option_value);
+			ctl::expect_ok(err.reason == args::value_errc::cant_parse);
+			ctl::expect_equal(err.token, 2);
+			ctl::expect_equal(err.value_token, 3);
+			ctl::expect_equal(err.name, "--num"sv);
+			ctl::expect_equal(err.value, "asd"sv);
+			ctl::expect_equal(err.message(), "Invalid value for option \"--num\". Can't parse \"asd\"."s);
+		});
+
+		it("invalid command option value", []{
+			const char* argv[] = {
+				"exec",
+				"cmd",
+				"--flag=asd"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto f = false;
+			auto p = args::parser{};
+			p.command("cmd", "c")
+				.option("--flag", &f);
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			auto& err = result.error();
+			ctl::expect_ok(err.code == args::errc::invalid_command_option_value);
+			ctl::expect_ok(err.reason == args::value_errc::not_flag_value);
+			ctl::expect_equal(err.token, 2);
+			ctl::expect_equal(err.command_name(), "cmd, c"s);
+			ctl::expect_equal(err.value, "asd"sv);
+		});
+
+		it("missing option", []{
+			const char* argv[] = {
+				"exec"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto s = ""s;
+			auto p = args::parser{}
+				.option(args::required, "-s", "--str", &s);
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			auto& err = result.error();
+			ctl::expect_ok(err.code == args::errc::missing_option);
+			ctl::expect_equal(err.token, -1);
+			ctl::expect_equal(err.message(), "Option \"-s, --str\" is required."s);
+		});
+
+		it("unexpected arg", []{
+			const char* argv[] = {
+				"exec",
+				"arg"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::parser{};
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::unexpected_arg);
+			ctl::expect_equal(result.error().token, 1);
+		});
+
+		it("handler error", []{
+			const char* argv[] = {
+				"exec",
+				"-n",
+				"1"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::parser{}
+				.option<int>("-n", [](auto) { throw std::runtime_error("Handler failed."); });
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			auto& err = result.error();
+			ctl::expect_ok(err.reason == args::value_errc::handler);
+			ctl::expect_equal(err.message(), "Invalid value for option \"-n\". Handler failed."s);
+		});
+
+		it("message matches exception", []{
+			const char* argv[] = {
+				"exec",
+				"cmd",
+				"asd"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto n = 0;
+			auto p = args::parser{};
+			p.command("cmd")
+				.arg("num", &n);
+
+			auto result = p.try_parse(argc, argv);
+			ctl::expect_fail(result.has_value());
+
+			auto what = ""s;
+			try {
+				p.parse(argc, argv);
+			} catch (const args::invalid_command_arg_value& err) {
+				what = err.what();
+			}
+			ctl::expect_equal(result.error().message(), what);
+		});
+	});
+
+	describe("Static parser", []{
+		it("options", []{
+			const char* argv[] = {
+				"exec",
+				"-b",
+				"-i12",
+				"--str=str",
+				"-v", "0",
+				"-v", "1",
+				"+fb", "on"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_option<bool, "-b">,
+				args::static_option<int, "-i", "--int">,
+				args::static_option<std::string, "--str", "Description">,
+				args::static_option<std::vector<int>, "-v", "--vector", "Description">,
+				args::static_option<bool, "+fb">
+			>{};
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(p.get<"-b">(), true);
+			ctl::expect_equal(p.get<"--int">(), 12);
+			ctl::expect_equal(p.get<"--str">(), "str"s);
+			ctl::expect_equal(p.get<"-v">(), {0, 1});
+			ctl::expect_equal(p.get<"+fb">(), true);
+			ctl::expect_ok(p.exists<"-i">());
+		});
+
+		it("grouped short flags, --no-long", []{
+			const char* argv[] = {
+				"exec",
+				"-rf",
+				"--no-color"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_option<bool, "-r">,
+				args::static_option<bool, "-f">,
+				args::static_option<bool, "--color">
+			>{};
+			p.get<"--color">() = true;
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(p.get<"-r">(), true);
+			ctl::expect_equal(p.get<"-f">(), true);
+			ctl::expect_equal(p.get<"--color">(), false);
+		});
+
+		it("args, rest, --", []{
+			const char* argv[] = {
+				"exec",
+				"a",
+				"1",
+				"--",
+				"-2"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_arg<std::string, "arg">,
+				args::static_rest<std::vector<int>, "rest">
+			>{};
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(p.get<"arg">(), "a"s);
+			ctl::expect_equal(p.get<"rest">(), {1, -2});
+		});
+
+		it("errors", []{
+			const char* argv[] = {
+				"exec",
+				"--num",
+				"asd"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_option<int, "-n", "--num">
+			>{};
+
+			auto result = p.try_parse(argc, argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::invalid_option_value);
+			ctl::expect_equal(result.error().message(), "Invalid value for option \"--num\". Can't parse \"asd\"."s);
+		});
+
+		it("matches option by its later name", []{
+			const char* argv[] = {"exec", "-jobs", "4", "-level=2"};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_option<int, "-j", "-jobs", "Number of jobs">,
+				args::static_option<int, "-l", "-level", "Level">
+			>{};
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(p.get<"-jobs">(), 4);
+			ctl::expect_equal(p.get<"-l">(), 2);
+		});
+
+		it("required throws", []{
+			const char* argv[] = {
+				"exec"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto p = args::static_parser<
+				args::static_required<args::static_option<int, "-n", "--num">>,
+				args::static_required<args::static_arg<int, "arg">>
+			>{};
+
+			auto what = ""s;
+			try {
+				p.parse(argc, argv);
+			} catch (const args::missing_option& err) {
+				what = err.what();
+			}
+
+			ctl::expect_equal(what, "Option \"-n, --num\" is required."s);
+		});
+
+		it("usage", []{
+			using cli = args::static_parser<
+				args::static_name<"cli">,
+				args::static_option<bool, "-b">,
+				args::static_required<args::static_option<int, "-n", "--num">>,
+				args::static_required<args::static_arg<int, "arg">>,
+				args::static_rest<std::vector<int>>
+			>;
+
+			static_assert(cli::usage.size() > 0);
+			ctl::expect_equal(cli::usage, "  cli --num=value [options] <arg> [<REST...>]\n"sv);
+		});
+
+		it("help and man match parser", []{
+			using cli = args::static_parser<
+				args::static_name<"cli">,
+				args::static_description<"Some text">,
+				args::static_option<bool, "-b", "--bool", "Bool flag">,
+				args::static_required<args::static_option<int, "-n", "Number">>,
+				args::static_option<int, "--very-long-option-name", "Long">,
+				args::static_arg<int, "arg", "Arg">,
+				args::static_rest<std::vector<int>, "rest", "Rest">
+			>;
+
+			auto b = false;
+			auto n = 0;
+			auto l = 0;
+			auto a = 0;
+			auto r = std::vector<int>{};
+			auto p = args::parser{}
+				.name("cli")
+				.description("Some text")
+				.option("-b", "--bool", "Bool flag", &b)
+				.option(args::required, "-n", "Number", &n)
+				.option("--very-long-option-name", "Long", &l)
+				.arg("arg", "Arg", &a)
+				.rest("rest", "Rest", &r);
+
+			ctl::expect_equal(cli::help, std::string_view{p.format_help()});
+			ctl::expect_equal(cli::man, std::string_view{p.format_man()});
+		});
+	});
+
+	describe("Bind", []{
+		it("struct fields", []{
+			const char* argv[] = {
+				"exec",
+				"-v",
+				"--jobs", "4",
+				"-o=out",
+				"-Ia",
+				"-Ib"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			struct config {
+				bool verbose = false;
+				int jobs = 1;
+				std::string out;
+				std::vector<std::string> include;
+			};
+
+			static constexpr args::field fields[] = {
+				{"-v", "--verbose", "Verbose output"},
+				{args::required, "-j", "--jobs", "Number of jobs"},
+				{"-o", "Output"},
+				{"-I"}
+			};
+
+			auto c = config{};
+			auto p = args::bind(&c, fields);
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(c.verbose, true);
+			ctl::expect_equal(c.jobs, 4);
+			ctl::expect_equal(c.out, "out"s);
+			ctl::expect_equal(c.include, {"a"s, "b"s});
+		});
+
+		it("required field throws", []{
+			const char* argv[] = {
+				"exec"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			struct config {
+				int jobs = 1;
+				double ratio = 0.0;
+			};
+
+			static constexpr args::field fields[] = {
+				{args::required, "-j", "--jobs"},
+				{"--ratio"}
+			};
+
+			auto c = config{};
+			auto p = args::parser{}
+				.bind(&c, fields);
+
+			auto what = ""s;
+			try {
+				p.parse(argc, argv);
+			} catch (const args::missing_option& err) {
+				what = err.what();
+			}
+
+			ctl::expect_equal(what, "Option \"-j, --jobs\" is required."s);
+		});
+	});
+
+	describe("Flags", []{
+		it("registered flags", []{
+			const char* argv[] = {
+				"exec",
+				"--jobs", "4",
+				"--verbose"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			ctl::expect_equal(*test_jobs, 1);
+			ctl::expect_equal(args::registered_flags().size(), std::size_t{2});
+
+			auto p = args::parser{}
+				.flags();
+
+			p.parse(argc, argv);
+
+			ctl::expect_equal(*test_jobs, 4);
+			ctl::expect_equal(test_verbose.get(), true);
+		});
+
+		it("cache line aligned value", []{
+			ctl::expect_equal(alignof(args::flag<int>), args::cache_line_size);
+			ctl::expect_equal(reinterpret_cast<std::uintptr_t>(&*test_jobs) % args::cache_line_size, std::uintptr_t{0});
+		});
+	});
+
+	describe("Man page", []{
+		it("format_man", []{
+			auto a = ""s;
+			auto c = false;
+			auto p = args::parser{}
+				.name("cli-cmd")
+				.description("Some text")
+				.option("-a", "--aa", "Option A", &a);
+
+			p.command("list", "l", "List command")
+				.option("-c", "Option C", &c);
+
+			ctl::expect_equal(p.format_man(),
+				".TH CLI\\-CMD 1\n"
+				".SH NAME\n"
+				"cli\\-cmd \\- Some text\n"
+				".SH SYNOPSIS\n"
+				".nf\n"
+				"  cli\\-cmd [options] [command] ...\n"
+				".fi\n"
+				".SH DESCRIPTION\n"
+				"Some text\n"
+				".SH OPTIONS\n"
+				".TP\n"
+				".B \\-a, \\-\\-aa\n"
+				"Option A\n"
+				".SH COMMANDS\n"
+				".TP\n"
+				".B list, l\n"
+				"List command\n"s);
+		});
+	});
+
+	describe("Reuse", []{
+		it("does not allocate when parsing again", []{
+			const char* argv[] = {
+				"exec",
+				"-n",
+				"42",
+				"--short=abc",
+				"--long",
+				"a-value-that-does-not-fit-in-place",
+				"--no-color",
+				"-v",
+				"7"
+			};
+			const int argc = std::distance(std::begin(argv), std::end(argv));
+
+			auto n = 0;
+			auto s = ""s;
+			auto l = ""s;
+			auto color = true;
+			auto v = false;
+			auto a = 0;
+			auto p = args::parser{}
+				.option("-n", &n)
+				.option("--short", &s)
+				.option("--long", &l)
+				.option("--color", &color)
+				.option("-v", &v)
+				.arg("ARG", &a);
+
+			p.parse(argc, argv);
+			auto before = allocation_count;
+			p.parse(argc, argv);
+			auto allocations = allocation_count - before;
+
+			ctl::expect_equal(allocations, std::size_t{0});
+			ctl::expect_equal(n, 42);
+			ctl::expect_equal(s, "abc"s);
+			ctl::expect_equal(l, "a-value-that-does-not-fit-in-place"s);
+			ctl::expect_equal(color, false);
+			ctl::expect_equal(v, true);
+			ctl::expect_equal(a, 7);
+		});
+
+		it("checks required options on every parse", []{
+			const char* first[] = {"exec", "--num", "1"};
+			const char* second[] = {"exec"};
+
+			auto n = 0;
+			auto p = args::parser{}
+				.option(args::required, "--num", &n);
+
+			auto ok = p.try_parse(std::size(first), first);
+			auto result = p.try_parse(std::size(second), second);
+
+			ctl::expect_ok(ok.has_value());
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::missing_option);
+			ctl::expect_equal(result.error().message(), "Option \"--num\" is required."s);
+		});
+
+		it("checks required command options on every parse", []{
+			const char* first[] = {"exec", "cmd", "--flag"};
+			const char* second[] = {"exec", "cmd"};
+
+			auto f = false;
+			auto p = args::parser{};
+			p.command("cmd", "c")
+				.option(args::required, "--flag", &f);
+
+			auto ok = p.try_parse(std::size(first), first);
+			auto result = p.try_parse(std::size(second), second);
+
+			ctl::expect_ok(ok.has_value());
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::missing_command_option);
+		});
+
+		it("static parser reset clears parsed state", []{
+			const char* argv[] = {"exec", "-i", "1"};
+
+			auto p = args::static_parser<
+				args::static_option<int, "-i", "--int">
+			>{};
+
+			p.parse(std::size(argv), argv);
+			ctl::expect_ok(p.exists<"-i">());
+
+			p.reset();
+			ctl::expect_fail(p.exists<"-i">());
+			ctl::expect_equal(p.get<"-i">(), 1);
+		});
+
+		it("try_parse reports help requests", []{
+			const char* argv[] = {"exec", "--help"};
+			const char* command_argv[] = {"exec", "c", "--help"};
+
+			auto p = args::parser{};
+			p.command("cmd", "c");
+
+			auto result = p.try_parse(std::size(argv), argv);
+			auto command_result = p.try_parse(std::size(command_argv), command_argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::help_requested);
+			ctl::expect_equal(result.error().token, 1);
+			ctl::expect_ok(result.error().command.empty());
+			ctl::expect_ok(command_result.error().code == args::errc::help_requested);
+			ctl::expect_equal(command_result.error().command, "cmd"sv);
+			ctl::expect_equal(command_result.error().command_alias, "c"sv);
+			ctl::expect_equal(command_result.error().message(), "Help requested."s);
+		});
+	});
+
+	describe("Parse context", []{
+		struct request {
+			int jobs = 0;
+			std::string name = ""s;
+			bool verbose = false;
+			std::vector<std::string> files = {};
+		};
+
+		it("parses into per call values", []{
+			const char* first[] = {"exec", "-j", "4", "--name=first", "a", "b"};
+			const char* second[] = {"exec", "--verbose", "--name", "second"};
+
+			const auto p = args::parser{}
+				.option("-j", "--jobs", &request::jobs)
+				.option("--name", &request::name)
+				.option("--verbose", &request::verbose)
+				.rest("FILES", &request::files);
+
+			auto first_context = args::parse_context{};
+			auto second_context = args::parse_context{};
+			auto first_values = request{};
+			auto second_values = request{};
+			p.parse(first_context, first_values, std::size(first), first);
+			p.parse(second_context, second_values, std::size(second), second);
+
+			ctl::expect_equal(first_values.jobs, 4);
+			ctl::expect_equal(first_values.name, "first"s);
+			ctl::expect_equal(first_values.verbose, false);
+			ctl::expect_equal(first_values.files, {"a"s, "b"s});
+			ctl::expect_equal(second_values.jobs, 0);
+			ctl::expect_equal(second_values.name, "second"s);
+			ctl::expect_equal(second_values.verbose, true);
+			ctl::expect_ok(second_values.files.empty());
+		});
+
+		it("keeps required state in the context", []{
+			const char* first[] = {"exec", "get", "-j", "1", "key"};
+			const char* second[] = {"exec", "get", "key"};
+
+			auto p = args::parser{};
+			p.command("get", "g")
+				.option(args::required, "-j", &request::jobs)
+				.arg("KEY", &request::name);
+
+			auto context = args::parse_context{};
+			auto values = request{};
+			auto ok = std::as_const(p).try_parse(context, values, std::size(first), first);
+			ctl::expect_ok(ok.has_value());
+			ctl::expect_equal(context.command(), "get"sv);
+			ctl::expect_equal(values.name, "key"s);
+
+			auto result = std::as_const(p).try_parse(context, values, std::size(second), second);
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::missing_command_option);
+			ctl::expect_equal(result.error().command, "get"sv);
+		});
+
+		it("no command", []{
+			const char* argv[] = {"exec", "-j", "1"};
+
+			auto p = args::parser{}
+				.option("-j", &request::jobs);
+			p.command("get");
+
+			auto context = args::parse_context{};
+			auto values = request{};
+			p.parse(context, values, std::size(argv), argv);
+
+			ctl::expect_equal(context.command(), ""sv);
+			ctl::expect_equal(values.jobs, 1);
+		});
+
+		it("member targets need matching values", []{
+			const char* argv[] = {"exec", "-j", "1"};
+
+			auto p = args::parser{}
+				.option("-j", &request::jobs);
+
+			auto context = args::parse_context{};
+			auto other = std::pair<int, int>{};
+			auto catched = 0;
+			try {
+				p.parse(context, std::size(argv), argv);
+			} catch (const std::runtime_error&) {
+				catched++;
+			}
+			try {
+				p.parse(context, other, std::size(argv), argv);
+			} catch (const std::runtime_error&) {
+				catched++;
+			}
+			ctl::expect_equal(catched, 2);
+		});
+	});
+
+	describe("Batch", []{
+		struct request {
+			int jobs = 0;
+			std::string key = ""s;
+		};
+
+		it("parses inputs into values by index", []{
+			auto p = args::parser{}
+				.option(args::required, "-j", &request::jobs)
+				.arg("KEY", &request::key);
+
+			auto jobs = std::vector<std::string>{};
+			for (auto i = 0; i < 1000; i++) {
+				jobs.push_back(i % 100 == 0 ? "bad"s : std::to_string(i));
+			}
+			auto argvs = std::vector<std::array<const char*, 4>>{};
+			for (auto& j : jobs) {
+				argvs.push_back({"exec", "-j", j.c_str(), "key"});
+			}
+			auto inputs = std::vector<args::argv_view>{};
+			for (auto& argv : argvs) {
+				inputs.push_back({static_cast<int>(argv.size()), argv.data()});
+			}
+
+			auto results = std::vector<std::optional<request>>(inputs.size());
+			auto errors = std::vector<args::value_errc>(inputs.size());
+			args::parse_batch<request>(p, inputs, [&](std::size_t index, std::expected<request, args::error> result) {
+				if (result) {
+					results[index] = *result;
+				} else {
+					errors[index] = result.error().reason;
+				}
+			}, 4);
+
+			for (std::size_t i = 0; i < inputs.size(); i++) {
+				if (i % 100 == 0) {
+					ctl::expect_fail(results[i].has_value());
+					ctl::expect_ok(errors[i] == args::value_errc::cant_parse);
+				} else {
+					ctl::expect_ok(results[i].has_value());
+					ctl::expect_equal(results[i]->jobs, static_cast<int>(i));
+					ctl::expect_equal(results[i]->key, "key"s);
+				}
+			}
+		});
+
+		it("validates inputs", []{
+			auto j = 0;
+			auto p = args::parser{}
+				.option(args::required, "-j", &j);
+
+			const char* valid[] = {"exec", "-j", "1"};
+			const char* missing[] = {"exec"};
+			auto inputs = std::vector<args::argv_view>(300, {static_cast<int>(std::size(valid)), valid});
+			inputs[150] = {static_cast<int>(std::size(missing)), missing};
+
+			auto failed = std::vector<std::size_t>{};
+			args::parse_batch(p, inputs, [&](std::size_t index, std::expected<void, args::error> result) {
+				if (!result) {
+					ctl::expect_ok(result.error().code == args::errc::missing_option);
+					failed.push_back(index);
+				}
+			}, 1);
+
+			ctl::expect_equal(failed, {std::size_t{150}});
+		});
+	});
+
+	describe("Result", []{
+		it("reads values by handles", []{
+			const char* argv[] = {"exec", "-j", "4", "--name=build", "-v", "a", "-v", "b", "--no-color", "get", "-f", "key", "x", "y"};
+
+			auto jobs = args::handle<int>{};
+			auto name = args::handle<std::string>{};
+			auto values = args::handle<std::vector<std::string>>{};
+			auto color = args::handle<bool>{};
+			auto force = args::handle<bool>{};
+			auto key = args::handle<std::string>{};
+			auto rest = args::handle<std::vector<std::string>>{};
+
+			auto p = args::parser{}
+				.option("-j", &jobs)
+				.option("--name", &name)
+				.option("-v", &values)
+				.option("--color", &color);
+			p.command("get")
+				.option("-f", &force)
+				.arg("KEY", &key)
+				.rest("REST", &rest);
+
+			auto context = args::parse_context{};
+			auto r = args::result{};
+			p.parse(context, r, std::size(argv), argv);
+
+			ctl::expect_equal(r[jobs], 4);
+			ctl::expect_equal(r[name], "build"s);
+			ctl::expect_equal(r[values], {"a"s, "b"s});
+			ctl::expect_equal(r[color], false);
+			ctl::expect_equal(r[force], true);
+			ctl::expect_equal(r[key], "key"s);
+			ctl::expect_equal(r[rest], {"x"s, "y"s});
+		});
+
+		it("resets values and reuses memory on every parse", []{
+			const char* first[] = {"exec", "-v", "1", "-v", "2", "--name", "a-value-that-does-not-fit-in-place", "-j", "1"};
+			const char* second[] = {"exec", "-v", "3"};
+
+			auto jobs = args::handle<int>{};
+			auto name = args::handle<std::string>{};
+			auto values = args::handle<std::vector<int>>{};
+			const auto p = args::parser{}
+				.option("-j", &jobs)
+				.option("--name", &name)
+				.option("-v", &values);
+
+			auto context = args::parse_context{};
+			auto r = args::result{};
+			p.parse(context, r, std::size(first), first);
+			ctl::expect_equal(r[values], {1, 2});
+
+			auto before = allocation_count;
+			p.parse(context, r, std::size(first), first);
+			ctl::expect_equal(allocation_count - before, std::size_t{0});
+
+			p.parse(context, r, std::size(second), second);
+			ctl::expect_equal(r[jobs], 0);
+			ctl::expect_equal(r[name], ""s);
+			ctl::expect_equal(r[values], {3});
+		});
+
+		it("copies are snapshots", []{
+			const char* first[] = {"exec", "--name", "first"};
+			const char* second[] = {"exec", "--name", "second"};
+
+			auto name = args::handle<std::string>{};
+			auto p = args::parser{}
+				.option("--name", &name);
+
+			auto context = args::parse_context{};
+			auto r = args::result{};
+			p.parse(context, r, std::size(first), first);
+			auto snapshot = r;
+			p.parse(context, r, std::size(second), second);
+			auto moved = std::move(snapshot);
+
+			ctl::expect_equal(r[name], "second"s);
+			ctl::expect_equal(moved[name], "first"s);
+		});
+
+		it("parse_batch fills results", []{
+			const char* argv[] = {"exec", "-j", "3"};
+
+			auto jobs = args::handle<int>{};
+			auto p = args::parser{}
+				.option(args::required, "-j", &jobs);
+
+			auto inputs = std::vector<args::argv_view>(10, {static_cast<int>(std::size(argv)), argv});
+			auto sum = 0;
+			args::parse_batch<args::result>(p, inputs, [&](std::size_t, std::expected<args::result, args::error> result) {
+				sum += (*result)[jobs];
+			}, 1);
+
+			ctl::expect_equal(sum, 30);
+		});
+
+		it("handles and member targets don't mix", []{
+			struct request {
+				int jobs = 0;
+			};
+
+			auto name = args::handle<std::string>{};
+			auto p = args::parser{}
+				.option("--name", &name);
+
+			auto catched = false;
+			try {
+				p.option("-j", &request::jobs);
+			} catch (const std::runtime_error&) {
+				catched = true;
+			}
+			ctl::expect_ok(catched);
+		});
+	});
+
+	describe("Repl", []{
+		struct console {
+			int jobs = 0;
+			bool verbose = false;
+			std::string key = ""s;
+			int called = 0;
+			args::parser schema;
+
+			console() {
+				this->schema
+					.option(args::required, "-j", "--jobs", &this->jobs)
+					.option("-v", "--verbose", &this->verbose);
+				this->schema.command("get", "g", "Get value")
+					.option("--raw", &this->verbose)
+					.arg(args::required, "KEY", &this->key)
+					.action([this] {
+						this->called++;
+					});
+				this->schema.command("multi word cmd");
+			}
+		};
+
+		it("validates lines without setting values", []{
+			auto c = console{};
+			auto r = args::repl{c.schema};
+
+			ctl::expect_ok(r.update("-j").code == args::errc::invalid_option_value);
+			ctl::expect_ok(r.update("-j 4 get").code == args::errc::missing_command_arg);
+			ctl::expect_ok(r.update("-j 4 get --nope key").code == args::errc::invalid_option);
+			ctl::expect_ok(r.update("get key").code == args::errc::missing_option);
+			ctl::expect_fail(static_cast<bool>(r.update("-j 4 get key")));
+			ctl::expect_equal(r.command(), "get"sv);
+			ctl::expect_equal(c.jobs, 0);
+			ctl::expect_equal(c.key, ""s);
+			ctl::expect_equal(c.called, 0);
+		});
+
+		it("executes the line", []{
+			auto c = console{};
+			auto r = args::repl{c.schema};
+
+			r.update(R"(-j 4 -v g "it's")");
+			auto result = r.execute();
+
+			ctl::expect_ok(result.has_value());
+			ctl::expect_equal(c.jobs, 4);
+			ctl::expect_equal(c.verbose, true);
+			ctl::expect_equal(c.key, "it's"s);
+			ctl::expect_equal(c.called, 1);
+		});
+
+		it("reparses only the changed tail", []{
+			auto c = console{};
+			auto r = args::repl{c.schema};
+
+			r.update("-j 4 get ke");
+			r.update("-j 4 get key");
+			ctl::expect_equal(r.stable_tokens(), std::size_t{3});
+			r.update("-j 4 get key --raw");
+			ctl::expect_equal(r.stable_tokens(), std::size_t{3});
+			r.update("-j 5 get key --raw");
+			ctl::expect_equal(r.stable_tokens(), std::size_t{0});
+			ctl::expect_fail(static_cast<bool>(r.update("-j 5 get key")));
+			ctl::expect_ok(r.update("-j 5 get").code == args::errc::missing_command_arg);
+		});
+
+		it("rescans tokens that looked ahead", []{
+			auto c = console{};
+			auto r = args::repl{c.schema};
+
+			ctl::expect_ok(r.update("-j 1 multi word").code == args::errc::unexpected_arg);
+			ctl::expect_fail(static_cast<bool>(r.update("-j 1 multi word cmd")));
+			ctl::expect_equal(r.command(), "multi word cmd"sv);
+			ctl::expect_ok(r.update("-j 1 --verbose ye").code == args::errc::unexpected_arg);
+			ctl::expect_fail(static_cast<bool>(r.update("-j 1 --verbose yes")));
+		});
+
+		it("completes options and commands", []{
+			auto c = console{};
+			auto r = args::repl{c.schema};
+			auto completions = [&](std::string_view line) {
+				r.update(line);
+				return std::vector<std::string_view>(std::begin(r.completions()), std::end(r.completions()));
+			};
+
+			ctl::expect_equal(completions("--ver"), std::vector<std::string_view>{"--verbose"});
+			ctl::expect_equal(completions("--no-"), std::vector<std::string_view>{"--no-verbose"});
+			ctl::expect_equal(completions("-j 4 g"), std::vector<std::string_view>{"g", "get"});
+			ctl::expect_equal(completions("-j 4 get --r"), std::vector<std::string_view>{"--raw"});
+			ctl::expect_equal(completions("-j "), std::vector<std::string_view>{});
+			ctl::expect_equal(completions("-j 4 get key "), std::vector<std::string_view>{});
+		});
+
+		it("executes with values of member targets", []{
+			struct request {
+				int jobs = 0;
+			};
+			auto p = args::parser{}
+				.option("-j", &request::jobs);
+			auto r = args::repl{p};
+
+			r.update("-j 7");
+			auto values = request{};
+			auto result = r.execute(values);
+
+			ctl::expect_ok(result.has_value());
+			ctl::expect_equal(values.jobs, 7);
+		});
+	});
+
+	describe("Run batch", []{
+		struct job {
+			int a = 0;
+			int b = 0;
+		};
+
+		auto capture_errors = [](auto run) {
+			auto errors = std::stringstream{};
+			auto saved = std::cerr.rdbuf(errors.rdbuf());
+			run();
+			std::cerr.rdbuf(saved);
+			return errors.str();
+		};
+
+		it("runs commands separated by ;; on many threads", []{
+			const char* argv[] = {"exec", "add", "1", "2", ";;", "add", "3", "4", ";;", ";;", "sub", "10", "5"};
+			auto sum = std::atomic<int>{0};
+			auto p = args::parser{};
+			p.command("add")
+				.arg(args::required, "A", &job::a)
+				.arg(args::required, "B", &job::b)
+				.action<job>([&](job& values) {
+					sum += values.a + values.b;
+				});
+			p.command("sub")
+				.arg(args::required, "A", &job::a)
+				.arg(args::required, "B", &job::b)
+				.action<job>([&](job& values) {
+					sum += values.a - values.b;
+				});
+
+			auto status = args::run_batch<job>(p, std::size(argv), argv, 4);
+
+			ctl::expect_equal(status.commands, std::size_t{3});
+			ctl::expect_equal(status.failed, std::size_t{0});
+			ctl::expect_equal(status.exit_code(), 0);
+			ctl::expect_equal(sum.load(), 15);
+		});
+
+		it("reports failed commands with their numbers", [=]{
+			const char* argv[] = {"exec", "add", "1", "2", ";;", "add", "--bad", ";;", "add", "1"};
+			auto sum = std::atomic<int>{0};
+			auto p = args::parser{};
+			p.command("add")
+				.arg(args::required, "A", &job::a)
+				.arg(args::required, "B", &job::b)
+				.action<job>([&](job& values) {
+					sum += values.a + values.b;
+				});
+
+			auto status = args::batch_status{};
+			auto errors = capture_errors([&] {
+				status = args::run_batch<job>(p, std::size(argv), argv, 1);
+			});
+
+			ctl::expect_equal(status.commands, std::size_t{3});
+			ctl::expect_equal(status.failed, std::size_t{2});
+			ctl::expect_equal(status.exit_code(), 1);
+			ctl::expect_equal(sum.load(), 4);
+			ctl::expect_equal(errors, "2: Invalid option \"--bad\".\n3: Command \"add\" argument \"B\" is required.\n"s);
+		});
+
+		it("runs one command per line", [=]{
+			auto input = std::istringstream{"add 1 2\n\nadd 'a' 3\nadd 3 4\n"};
+			auto sum = std::atomic<int>{0};
+			auto p = args::parser{};
+			p.command("add")
+				.arg(args::required, "A", &job::a)
+				.arg(args::required, "B", &job::b)
+				.action<job>([&](job& values) {
+					sum += values.a + values.b;
+				});
+
+			auto status = args::batch_status{};
+			auto errors = capture_errors([&] {
+				status = args::run_batch<job>(p, input);
+			});
+
+			ctl::expect_equal(status.commands, std::size_t{3});
+			ctl::expect_equal(status.failed, std::size_t{1});
+			ctl::expect_equal(sum.load(), 10);
+			ctl::expect_equal(errors, "3: Invalid value for command \"add\" argument  \"A\". Can't parse \"a\".\n"s);
+		});
+
+		it("runs commands with pointer destinations one by one", []{
+			const char* argv[] = {"exec", "add", "1", ";;", "add", "2", ";;", "add", "3"};
+			auto a = 0;
+			auto sum = 0;
+			auto p = args::parser{};
+			p.command("add")
+				.arg(args::required, "A", &a)
+				.action([&] {
+					sum += a;
+				});
+
+			auto status = args::run_batch(p, std::size(argv), argv, 8);
+
+			ctl::expect_equal(status.failed, std::size_t{0});
+			ctl::expect_equal(sum, 6);
+		});
+
+		it("passes values to actions", []{
+			const char* argv[] = {"exec", "add", "1", "2"};
+			auto sum = 0;
+			auto p = args::parser{};
+			p.command("add")
+				.arg("A", &job::a)
+				.arg("B", &job::b)
+				.action<job>([&](job& values) {
+					sum = values.a + values.b;
+				});
+
+			auto context = args::parse_context{};
+			auto values = job{};
+			p.parse(context, values, std::size(argv), argv);
+
+			ctl::expect_equal(sum, 3);
+		});
+	});
+
+	describe("Parallel rest", []{
+		auto values_argv = [](int count) {
+			static auto values = std::vector<std::string>{};
+			values.clear();
+			for (auto i = 0; i < count; i++) {
+				values.push_back(std::to_string(i));
+			}
+			auto argv = std::vector<const char*>{"exec"};
+			for (auto& value : values) {
+				argv.push_back(value.c_str());
+			}
+			return argv;
+		};
+
+		auto scramble = [](int value) {
+			std::this_thread::sleep_for(std::chrono::microseconds((value * 7919) % 13 * 50));
+		};
+
+		it("runs the handler for every value", [=]{
+			auto argv = values_argv(100);
+			auto sum = std::atomic<int>{0};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [&](int value) {
+					sum += value;
+				}, 4);
+
+			p.parse(argv.size(), argv.data());
+
+			ctl::expect_equal(sum.load(), 4950);
+		});
+
+		it("collects results in order", [=]{
+			auto argv = values_argv(50);
+			auto results = std::vector<int>{};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [&](int value) {
+					scramble(value);
+					return value * 2;
+				}, &results, 4);
+
+			p.parse(argv.size(), argv.data());
+
+			auto expected = std::vector<int>{};
+			for (auto i = 0; i < 50; i++) {
+				expected.push_back(i * 2);
+			}
+			ctl::expect_equal(results, expected);
+		});
+
+		it("collects results in completion order", [=]{
+			auto argv = values_argv(50);
+			auto results = std::vector<int>{};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [&](int value) {
+					scramble(value);
+					return value * 2;
+				}, &results, 4, args::order::unordered);
+
+			p.parse(argv.size(), argv.data());
+
+			std::sort(std::begin(results), std::end(results));
+			auto expected = std::vector<int>{};
+			for (auto i = 0; i < 50; i++) {
+				expected.push_back(i * 2);
+			}
+			ctl::expect_equal(results, expected);
+		});
+
+		it("reports the first handler exception as arg value error", [=]{
+			auto argv = values_argv(40);
+			auto handled = std::atomic<int>{0};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [&](int value) {
+					scramble(value);
+					handled++;
+					if (value == 13 || value == 31) {
+						throw std::runtime_error("bad value " + std::to_string(value));
+					}
+				}, 4);
+
+			auto result = p.try_parse(argv.size(), argv.data());
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::invalid_arg_value);
+			ctl::expect_ok(result.error().reason == args::value_errc::handler);
+			ctl::expect_equal(result.error().token, 14);
+			ctl::expect_equal(result.error().value, "13"sv);
+			ctl::expect_equal(result.error().message(), "Invalid value for argument \"VALUES\". bad value 13"s);
+			ctl::expect_equal(handled.load(), 40);
+		});
+
+		it("lets the same exceptions escape as rest", []{
+			const char* argv[] = {"exec", "1", "2"};
+			auto throw_logic = [](int) {
+				throw std::logic_error("logic");
+			};
+			for (auto parallel : {false, true}) {
+				auto p = args::parser{};
+				if (parallel) {
+					p.rest_parallel<int>("VALUES", throw_logic, 2);
+				} else {
+					p.rest<int>("VALUES", throw_logic);
+				}
+				auto catched = 0;
+				try {
+					p.parse(std::size(argv), argv);
+				} catch (const std::logic_error& err) {
+					ctl::expect_equal(std::string{err.what()}, "logic"s);
+					catched++;
+				}
+				ctl::expect_equal(catched, 1);
+			}
+
+			auto err = args::error{args::errc::invalid_arg_value, args::value_errc::handler};
+			err.name = "VALUES";
+			err.cause = std::make_exception_ptr(42);
+			ctl::expect_equal(err.message(), "Invalid value for argument \"VALUES\". Handler failed."s);
+		});
+
+		it("reports values that can't be converted while parsing", []{
+			const char* argv[] = {"exec", "1", "x", "3"};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [](int) {}, 2);
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().reason == args::value_errc::cant_parse);
+			ctl::expect_equal(result.error().token, 2);
+		});
+
+		it("runs command rest handlers before the action", []{
+			const char* argv[] = {"exec", "hash", "a", "bb", "ccc"};
+			auto sizes = std::vector<std::size_t>{};
+			auto total = std::size_t{0};
+			auto p = args::parser{};
+			p.command("hash")
+				.rest_parallel<std::string>("FILES", [](const std::string& file) {
+					return file.size();
+				}, &sizes, 2)
+				.action([&] {
+					for (auto size : sizes) {
+						total += size;
+					}
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(sizes, std::vector<std::size_t>{1, 2, 3});
+			ctl::expect_equal(total, std::size_t{6});
+		});
+
+		it("takes description and required like rest", []{
+			auto sizes = std::vector<std::size_t>{};
+			auto p = args::parser{}
+				.rest_parallel<std::string>(args::required, "FILES", "Files to measure", [](const std::string& file) {
+					return file.size();
+				}, &sizes, 2);
+			p.name("exec");
+
+			ctl::expect_ok(p.format_help().find("FILES             Files to measure") != std::string::npos);
+
+			const char* empty[] = {"exec"};
+			auto result = p.try_parse(std::size(empty), empty);
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::missing_arg);
+
+			const char* argv[] = {"exec", "a", "bb"};
+			p.parse(std::size(argv), argv);
+			ctl::expect_equal(sizes, std::vector<std::size_t>{1, 2});
+		});
+
+		it("keeps the pool threads between parses", []{
+			auto calls = std::atomic<int>{0};
+			auto p = args::parser{}
+				.rest_parallel<int>("VALUES", [&](int) {
+					thread_local auto thread_calls = 0;
+					thread_calls++;
+					auto current = calls.load();
+					while (current < thread_calls && !calls.compare_exchange_weak(current, thread_calls)) {
+					}
+				}, 1);
+
+			const char* argv[] = {"exec", "1", "2", "3"};
+			p.parse(std::size(argv), argv);
+			const char* invalid[] = {"exec", "1", "x"};
+			auto result = p.try_parse(std::size(invalid), invalid);
+			ctl::expect_fail(result.has_value());
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_ok(calls.load() >= 6);
+		});
+	});
+
+	describe("Bulk rest", []{
+		it("passes the tail after -- in one call", []{
+			const char* argv[] = {"exec", "--", "a", "-b", "--", "c"};
+			auto calls = 0;
+			auto values = std::vector<std::string_view>{};
+			auto p = args::parser{}
+				.rest_bulk("FILES", [&](std::span<const std::string_view> files) {
+					calls++;
+					values.assign(std::begin(files), std::end(files));
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(calls, 1);
+			ctl::expect_equal(values, std::vector<std::string_view>{"a", "-b", "--", "c"});
+		});
+
+		it("passes values before -- one by one", []{
+			const char* argv[] = {"exec", "a", "--verbose", "b", "--", "c", "d"};
+			auto verbose = false;
+			auto calls = std::vector<std::vector<std::string_view>>{};
+			auto p = args::parser{}
+				.option("--verbose", &verbose)
+				.rest_bulk("FILES", [&](std::span<const std::string_view> files) {
+					calls.emplace_back(std::begin(files), std::end(files));
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(verbose, true);
+			ctl::expect_equal(calls.size(), std::size_t{3});
+			ctl::expect_equal(calls[0], std::vector<std::string_view>{"a"});
+			ctl::expect_equal(calls[1], std::vector<std::string_view>{"b"});
+			ctl::expect_equal(calls[2], std::vector<std::string_view>{"c", "d"});
+		});
+
+		it("fills positional args before the tail", []{
+			const char* argv[] = {"exec", "cp", "--", "-dest", "x", "y"};
+			auto dest = ""s;
+			auto sources = std::vector<std::string_view>{};
+			auto p = args::parser{};
+			p.command("cp")
+				.arg("DEST", &dest)
+				.rest_bulk(args::required, "SOURCES", [&](std::span<const std::string_view> files) {
+					sources.assign(std::begin(files), std::end(files));
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(dest, "-dest"s);
+			ctl::expect_equal(sources, std::vector<std::string_view>{"x", "y"});
+		});
+
+		it("converts values", []{
+			const char* argv[] = {"exec", "--", "1", "2", "3"};
+			auto sum = 0;
+			auto p = args::parser{}
+				.rest_bulk<int>("NUMBERS", [&](std::span<const int> numbers) {
+					for (auto n : numbers) {
+						sum += n;
+					}
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(sum, 6);
+		});
+
+		it("reports the value that can't be converted", []{
+			const char* argv[] = {"exec", "--", "1", "x", "3"};
+			auto called = false;
+			auto p = args::parser{}
+				.rest_bulk<int>("NUMBERS", [&](std::span<const int>) {
+					called = true;
+				});
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_fail(called);
+			ctl::expect_ok(result.error().code == args::errc::invalid_arg_value);
+			ctl::expect_equal(result.error().token, 3);
+			ctl::expect_equal(result.error().value, "x"sv);
+		});
+
+		it("checks required bulk rest", []{
+			const char* argv[] = {"exec", "--"};
+			auto p = args::parser{}
+				.rest_bulk(args::required, "FILES", [](std::span<const std::string_view>) {});
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::missing_arg);
+		});
+	});
+
+	describe("Nargs options", []{
+		it("takes fixed number of values", []{
+			const char* argv[] = {"exec", "--point", "1", "2", "file"};
+			auto point = std::vector<int>{};
+			auto file = ""s;
+			auto p = args::parser{}
+				.option(args::nargs{2}, "--point", &point)
+				.arg("FILE", &file);
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(point, std::vector<int>{1, 2});
+			ctl::expect_equal(file, "file"s);
+		});
+
+		it("takes values up to the next option", []{
+			const char* argv[] = {"exec", "-i", "a", "b", "c", "--verbose", "-i", "d"};
+			auto inputs = std::vector<std::string>{};
+			auto verbose = false;
+			auto p = args::parser{}
+				.option(args::nargs{'+'}, "-i", "--inputs", "Input files", &inputs)
+				.option("--verbose", &verbose);
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(inputs, std::vector<std::string>{"a", "b", "c", "d"});
+			ctl::expect_equal(verbose, true);
+		});
+
+		it("takes no values", []{
+			const char* argv[] = {"exec", "--tags", "--verbose"};
+			auto tags = std::vector<std::string>{"old"};
+			auto verbose = false;
+			auto p = args::parser{}
+				.option(args::required, args::nargs{'*'}, "--tags", &tags)
+				.option("--verbose", &verbose);
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(tags, std::vector<std::string>{"old"});
+			ctl::expect_equal(verbose, true);
+		});
+
+		it("delivers values in one call", []{
+			const char* argv[] = {"exec", "--sum", "1", "2", "3"};
+			auto calls = 0;
+			auto sum = 0;
+			auto p = args::parser{}
+				.option<int>(args::nargs{'+'}, "--sum", [&](std::span<const int> numbers) {
+					calls++;
+					for (auto n : numbers) {
+						sum += n;
+					}
+				});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(calls, 1);
+			ctl::expect_equal(sum, 6);
+		});
+
+		it("inserts into member and handle targets", []{
+			struct values_t {
+				std::set<int> ids = {};
+			};
+			const char* argv[] = {"exec", "--ids", "3", "1", "2"};
+			auto p = args::parser{}
+				.option(args::nargs{'+'}, "--ids", &values_t::ids);
+			auto context = args::parse_context{};
+			auto values = values_t{};
+
+			p.parse(context, values, std::size(argv), argv);
+
+			ctl::expect_equal(values.ids, std::set<int>{1, 2, 3});
+
+			auto ids = args::handle<std::vector<int>>{};
+			auto q = args::parser{}
+				.option(args::nargs{3}, "--ids", &ids);
+			auto r = args::result{};
+
+			q.parse(context, r, std::size(argv), argv);
+
+			ctl::expect_equal(r[ids], std::vector<int>{3, 1, 2});
+		});
+
+		it("reports not enough values", []{
+			const char* argv[] = {"exec", "--point", "1", "--verbose"};
+			auto point = std::vector<int>{};
+			auto verbose = false;
+			auto p = args::parser{}
+				.option(args::nargs{2}, "--point", &point)
+				.option("--verbose", &verbose);
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().code == args::errc::invalid_option_value);
+			ctl::expect_ok(result.error().reason == args::value_errc::not_enough_values);
+			ctl::expect_equal(result.error().message(), "Invalid value for option \"--point\". Not enough values."s);
+			ctl::expect_equal(point.size(), std::size_t{0});
+		});
+
+		it("reports the value that can't be converted", []{
+			const char* argv[] = {"exec", "--point", "1", "x"};
+			auto point = std::vector<int>{};
+			auto p = args::parser{}
+				.option(args::nargs{2}, "--point", &point);
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_fail(result.has_value());
+			ctl::expect_equal(result.error().token, 1);
+			ctl::expect_equal(result.error().value_token, 3);
+			ctl::expect_equal(result.error().value, "x"sv);
+			ctl::expect_equal(point.size(), std::size_t{0});
+		});
+
+		it("takes one value from assignment", []{
+			const char* argv[] = {"exec", "--inputs=a", "--point=1"};
+			auto inputs = std::vector<std::string>{};
+			auto point = std::vector<int>{};
+			auto p = args::parser{}
+				.option(args::nargs{'+'}, "--inputs", &inputs)
+				.option(args::nargs{2}, "--point", &point);
+
+			auto result = p.try_parse(std::size(argv), argv);
+
+			ctl::expect_equal(inputs, std::vector<std::string>{"a"});
+			ctl::expect_fail(result.has_value());
+			ctl::expect_ok(result.error().reason == args::value_errc::not_enough_values);
+		});
+
+		it("validates in repl", []{
+			auto point = std::vector<int>{};
+			auto file = ""s;
+			auto p = args::parser{}
+				.option(args::nargs{2}, "--point", &point)
+				.arg(args::required, "FILE", &file);
+			auto r = args::repl{p};
+
+			ctl::expect_ok(r.update("--point 1").reason == args::value_errc::not_enough_values);
+			ctl::expect_ok(r.update("--point 1 2").code == args::errc::missing_arg);
+			ctl::expect_ok(r.update("--point 1 2 file").code == args::errc::none);
+		});
+	});
+
+	describe("Lazy commands", []{
+		it("builds only the selected command", []{
+			const char* argv[] = {"exec", "get", "--raw", "key"};
+			auto built = std::vector<std::string>{};
+			auto raw = false;
+			auto key = ""s;
+			auto p = args::parser{};
+			p.command("get", "g", "Get value", [&](auto& c) {
+				built.push_back("get");
+				c.option("--raw", &raw)
+					.arg(args::required, "KEY", &key);
+			});
+			p.command("set", "Set value", [&](auto& c) {
+				built.push_back("set");
+				c.arg(args::required, "KEY", &key);
+			});
+
+			p.parse(std::size(argv), argv);
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(built, std::vector<std::string>{"get"});
+			ctl::expect_equal(raw, true);
+			ctl::expect_equal(key, "key"s);
+		});
+
+		it("keeps action set before build", []{
+			const char* argv[] = {"exec", "g", "key"};
+			auto called = 0;
+			auto key = ""s;
+			auto p = args::parser{};
+			p.command("get", "g", [&](auto& c) {
+				c.arg(args::required, "KEY", &key);
+			}).action([&] {
+				called++;
+			});
+
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(called, 1);
+			ctl::expect_equal(key, "key"s);
+		});
+
+		it("builds for help and member targets", []{
+			struct request {
+				int jobs = 0;
+			};
+			const char* argv[] = {"exec", "run", "-j", "4"};
+			auto built = 0;
+			auto p = args::parser{};
+			p.command("run", [&](auto& c) {
+				built++;
+				c.option("-j", "--jobs", "Number of jobs", &request::jobs);
+			});
+
+			ctl::expect_equal(p.format_help().find("--jobs"), std::string::npos);
+			ctl::expect_ok(p.format_command_help("run").find("-j, --jobs        Number of jobs") != std::string::npos);
+
+			auto context = args::parse_context{};
+			auto values = request{};
+			p.parse(context, values, std::size(argv), argv);
+
+			ctl::expect_equal(built, 1);
+			ctl::expect_equal(values.jobs, 4);
+		});
+
+		it("lists lazy commands in usage without building them", []{
+			const char* argv[] = {"exec"};
+			auto built = 0;
+			auto raw = false;
+			auto p = args::parser{};
+			p.command_required();
+			p.command("get", "g", "Get value", [&](auto& c) {
+				built++;
+				c.option("--raw", &raw);
+			});
+			p.command("list")
+				.option("--all", &raw);
+
+			ctl::expect_equal(p.format_usage("  "), "  CMD get|g ...\n  CMD list [options]\n"s);
+			ctl::expect_ok(p.format_help().find("Get value") != std::string::npos);
+
+			auto catched = 0;
+			try {
+				p.parse(std::size(argv), argv);
+			} catch (const args::missing_command&) {
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+
+			ctl::expect_equal(built, 0);
+		});
+
+		it("builds in repl when selected", []{
+			auto built = 0;
+			auto key = ""s;
+			auto p = args::parser{};
+			p.command("get", [&](auto& c) {
+				built++;
+				c.option("--raw", &key)
+					.arg(args::required, "KEY", &key);
+			});
+			p.command("set", [&](auto&) {
+				built++;
+			});
+			auto r = args::repl{p};
+
+			ctl::expect_equal(built, 0);
+			ctl::expect_ok(r.update("get").code == args::errc::missing_command_arg);
+			r.update("get --r");
+
+			ctl::expect_equal(built, 1);
+			ctl::expect_equal(std::vector<std::string_view>(std::begin(r.completions()), std::end(r.completions())), std::vector<std::string_view>{"--raw"});
+		});
+
+		it("rejects handle targets", []{
+			const char* argv[] = {"exec", "get"};
+			auto key = args::handle<std::string>{};
+			auto p = args::parser{};
+			p.command("get", [&](auto& c) {
+				c.arg("KEY", &key);
+			});
+
+			auto catched = 0;
+			try {
+				p.parse(std::size(argv), argv);
+			} catch (const std::runtime_error&) {
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+		});
+	});
+
+#ifdef ARGS_UNIX_SOCKETS
+	describe("Serve", []{
+		auto forward_captured = [](const std::string& socket, std::vector<const char*> argv, std::string& output) {
+			int out[2] = {};
+			ctl::expect_equal(::pipe(out), 0);
+			auto saved_stdout = ::dup(STDOUT_FILENO);
+			std::cout.flush();
+			::dup2(out[1], STDOUT_FILENO);
+			::close(out[1]);
+			auto status = args::forward(socket, static_cast<int>(argv.size()), argv.data());
+			::dup2(saved_stdout, STDOUT_FILENO);
+			::close(saved_stdout);
+			char buffer[256];
+			auto size = ::read(out[0], buffer, sizeof(buffer));
+			output.assign(buffer, size > 0 ? size : 0);
+			::close(out[0]);
+			return status;
+		};
+
+		it("runs invocations in the server", [=]{
+			auto socket = "/tmp/args-test-"s + std::to_string(::getpid()) + ".sock";
+			auto name = ""s;
+			auto p = args::parser{};
+			p.command("hello")
+				.option(args::required, "--name", &name)
+				.action([&] {
+					auto suffix = std::getenv("ARGS_TEST_SUFFIX");
+					std::cout << "hello " << name << (suffix ? suffix : "") << std::endl;
+				});
+
+			auto server = ::fork();
+			if (server == 0) {
+				args::serve(p, socket);
+				::_exit(1);
+			}
+
+			auto output = ""s;
+			auto status = -1;
+			for (auto attempt = 0; attempt < 500 && status < 0; attempt++) {
+				status = forward_captured(socket, {"exec", "hello", "--name", "world"}, output);
+				if (status < 0) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			}
+			ctl::expect_equal(status, 0);
+			ctl::expect_equal(output, "hello world\n"s);
+
+			::setenv("ARGS_TEST_SUFFIX", "!", 1);
+			status = forward_captured(socket, {"exec", "hello", "--name", "again"}, output);
+			::unsetenv("ARGS_TEST_SUFFIX");
+			ctl::expect_equal(status, 0);
+			ctl::expect_equal(output, "hello again!\n"s);
+
+			auto saved_stderr = ::dup(STDERR_FILENO);
+			auto null = ::open("/dev/null", O_WRONLY);
+			::dup2(null, STDERR_FILENO);
+			status = forward_captured(socket, {"exec", "hello"}, output);
+			::dup2(saved_stderr, STDERR_FILENO);
+			::close(saved_stderr);
+			::close(null);
+			ctl::expect_equal(status, 1);
+			ctl::expect_equal(output, ""s);
+
+			::kill(server, SIGTERM);
+			::waitpid(server, nullptr, 0);
+			::unlink(socket.c_str());
+			ctl::expect_equal(forward_captured(socket, {"exec", "hello"}, output), -1);
+		});
+
+		it("prints help without flushing the server stdio buffers", [=]{
+			auto socket = "/tmp/args-test-help-"s + std::to_string(::getpid()) + ".sock";
+			auto pending = "/tmp/args-test-help-"s + std::to_string(::getpid()) + ".pending";
+			auto p = args::parser{};
+			p.name("exec");
+			p.command("hello", "Say hello");
+
+			auto server = ::fork();
+			if (server == 0) {
+				auto file = std::fopen(pending.c_str(), "w");
+				std::setvbuf(file, nullptr, _IOFBF, 4096);
+				std::fputs("pending", file);
+				args::serve(p, socket);
+				::_exit(1);
+			}
+
+			auto output = ""s;
+			auto status = -1;
+			for (auto attempt = 0; attempt < 500 && status < 0; attempt++) {
+				status = forward_captured(socket, {"exec", "--help"}, output);
+				if (status < 0) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			}
+			ctl::expect_equal(status, 0);
+			ctl::expect_equal(output, p.format_help());
+
+			::kill(server, SIGTERM);
+			::waitpid(server, nullptr, 0);
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(pending, content));
+			ctl::expect_equal(content, ""s);
+			::unlink(socket.c_str());
+			::unlink(pending.c_str());
+		});
+	});
+#endif
+
+#ifdef ARGS_EXTERNAL_COMMANDS
+	describe("External commands", []{
+		auto write_script = [](const std::string& path, const std::string& content, mode_t mode) {
+			auto file = std::fopen(path.c_str(), "w");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+			::chmod(path.c_str(), mode);
+		};
+
+		it("finds executables on PATH through the cached index", [=]{
+			auto root = "/tmp/args-test-external-"s + std::to_string(::getpid());
+			auto first = root + "/first";
+			auto second = root + "/second";
+			auto cache = root + "/index";
+			::mkdir(root.c_str(), 0755);
+			::mkdir(first.c_str(), 0755);
+			::mkdir(second.c_str(), 0755);
+			write_script(first + "/tool-hello", "#!/bin/sh\n", 0755);
+			write_script(second + "/tool-hello", "#!/bin/sh\n", 0755);
+			write_script(second + "/tool-data", "", 0644);
+			auto saved_path = std::string{std::getenv("PATH")};
+			::setenv("PATH", (first + ":" + second).c_str(), 1);
+
+			ctl::expect_equal(args::find_external_command("tool-", cache, "hello"), first + "/tool-hello");
+			ctl::expect_equal(args::find_external_command("tool-", cache, "data"), ""s);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "missing"), ""s);
+
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(cache, content));
+			content += "fake\t/bin/true\n";
+			write_script(cache, content, 0644);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "fake"), "/bin/true"s);
+
+			write_script(second + "/tool-new", "#!/bin/sh\n", 0755);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "new"), second + "/tool-new");
+			ctl::expect_equal(args::find_external_command("tool-", cache, "fake"), ""s);
+
+			::setenv("PATH", saved_path.c_str(), 1);
+			for (auto file : {first + "/tool-hello", second + "/tool-hello", second + "/tool-data", second + "/tool-new", cache}) {
+				::unlink(file.c_str());
+			}
+			::rmdir(first.c_str());
+			::rmdir(second.c_str());
+			::rmdir(root.c_str());
+		});
+
+		it("keeps the index in memory between lookups", [=]{
+			auto root = "/tmp/args-test-external-memory-"s + std::to_string(::getpid());
+			auto cache = root + ".index";
+			::mkdir(root.c_str(), 0755);
+			write_script(root + "/tool-hello", "#!/bin/sh\n", 0755);
+			auto saved_path = std::string{std::getenv("PATH")};
+			::setenv("PATH", root.c_str(), 1);
+
+			ctl::expect_equal(args::find_external_command("tool-", cache, "hello"), root + "/tool-hello");
+
+			struct stat status;
+			ctl::expect_equal(::stat(cache.c_str(), &status), 0);
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(cache, content));
+			auto renamed = content;
+			renamed.replace(renamed.rfind("tool-hello"), 10, "tool-howdy");
+			write_script(cache, renamed, 0644);
+#ifdef __APPLE__
+			struct timespec times[2] = {status.st_atimespec, status.st_mtimespec};
+#else
+			struct timespec times[2] = {status.st_atim, status.st_mtim};
+#endif
+			ctl::expect_equal(::utimensat(AT_FDCWD, cache.c_str(), times, 0), 0);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "hello"), root + "/tool-hello");
+
+			write_script(cache, renamed + "extra\t/bin/true\n", 0644);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "hello"), root + "/tool-howdy");
+			ctl::expect_equal(args::find_external_command("tool-", cache, "extra"), "/bin/true"s);
+
+			::unlink((root + "/tool-hello").c_str());
+			ctl::expect_equal(args::find_external_command("tool-", cache, "extra"), "/bin/true"s);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "missing"), ""s);
+			ctl::expect_equal(args::find_external_command("tool-", cache, "extra"), ""s);
+
+			::setenv("PATH", saved_path.c_str(), 1);
+			::unlink(cache.c_str());
+			::rmdir(root.c_str());
+		});
+
+		it("runs unknown command with the rest of argv", [=]{
+			auto root = "/tmp/args-test-external-run-"s + std::to_string(::getpid());
+			auto cache = root + ".index";
+			auto output = root + "/output";
+			::mkdir(root.c_str(), 0755);
+			write_script(root + "/tool-hello", "#!/bin/sh\necho \"$*\" > " + output + "\n", 0755);
+			auto saved_path = std::string{std::getenv("PATH")};
+			::setenv("PATH", root.c_str(), 1);
+
+			auto verbose = false;
+			auto p = args::parser{}
+				.option("-v", &verbose)
+				.external_commands("tool-", cache);
+			p.command("list");
+
+			const char* known[] = {"exec", "-v", "list", nullptr};
+			p.parse(3, known);
+			ctl::expect_fail(::access(cache.c_str(), F_OK) == 0);
+
+			auto child = ::fork();
+			if (child == 0) {
+				const char* argv[] = {"exec", "-v", "hello", "a", "--b", "past-argc"};
+				try {
+					p.parse(5, argv);
+				} catch (...) {
+				}
+				::_exit(1);
+			}
+			auto status = 0;
+			::waitpid(child, &status, 0);
+			::setenv("PATH", saved_path.c_str(), 1);
+
+			ctl::expect_ok(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(output, content));
+			ctl::expect_equal(content, "a --b\n"s);
+
+			const char* unknown[] = {"exec", "nope", nullptr};
+			auto catched = 0;
+			try {
+				p.parse(2, unknown);
+			} catch (const args::unexpected_arg&) {
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+
+			for (auto file : {root + "/tool-hello", cache, output}) {
+				::unlink(file.c_str());
+			}
+			::rmdir(root.c_str());
+		});
+	});
+#endif
+
+#ifdef ARGS_PLUGINS
+	describe("Plugins", []{
+		it("loads plugin command from manifest when selected", []{
+			char cwd[4096];
+			ctl::expect_ok(::getcwd(cwd, sizeof(cwd)) != nullptr);
+			auto directory = "/tmp/args-test-plugins-"s + std::to_string(::getpid());
+			auto cache = directory + ".cache";
+			auto library = directory + "/stats.so";
+			::mkdir(directory.c_str(), 0755);
+			::symlink((std::string{cwd} + "/test/plugin.so").c_str(), library.c_str());
+
+			auto plugins = args::scan_plugins(directory, cache);
+
+			ctl::expect_equal(plugins.size(), std::size_t{1});
+			ctl::expect_equal(plugins[0].name, "stats"s);
+			ctl::expect_equal(plugins[0].alias, "st"s);
+			ctl::expect_equal(plugins[0].description, "Print statistics"s);
+			ctl::expect_equal(plugins[0].library, library);
+
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(cache, content));
+			content += "ghost\t\tMissing plugin\t/nonexistent/ghost.so\n";
+			auto file = std::fopen(cache.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+
+			plugins = args::scan_plugins(directory, cache);
+			ctl::expect_equal(plugins.size(), std::size_t{2});
+
+			auto p = args::parser{}
+				.plugins(plugins);
+			ctl::expect_ok(p.format_help().find("ghost") != std::string::npos);
+
+			const char* argv[] = {"exec", "st", "--top", "3", "a", "b"};
+			p.parse(std::size(argv), argv);
+
+			auto handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_NOLOAD);
+			ctl::expect_ok(handle != nullptr);
+			auto top = reinterpret_cast<int (*)()>(::dlsym(handle, "plugin_top"));
+			auto items = reinterpret_cast<std::size_t (*)()>(::dlsym(handle, "plugin_items"));
+			ctl::expect_equal(top(), 3);
+			ctl::expect_equal(items(), std::size_t{2});
+			::dlclose(handle);
+
+			const char* ghost[] = {"exec", "ghost"};
+			auto catched = 0;
+			try {
+				p.parse(std::size(ghost), ghost);
+			} catch (const std::runtime_error&) {
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+
+			auto readme = directory + "/README";
+			std::fclose(std::fopen(readme.c_str(), "w"));
+			plugins = args::scan_plugins(directory, cache);
+			ctl::expect_equal(plugins.size(), std::size_t{1});
+
+			::unlink(readme.c_str());
+			::unlink(library.c_str());
+			::unlink(cache.c_str());
+			::rmdir(directory.c_str());
+		});
+	});
+#endif
+
+#ifdef ARGS_RESPONSE_FILES
+	describe("Response files", []{
+		auto write_file = [](const std::string& path, const std::string& content) {
+			auto file = std::fopen(path.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+		};
+
+		it("expands @path tokens with quotes and escapes", [=]{
+			auto path = "/tmp/args-test-response-"s + std::to_string(::getpid());
+			write_file(path, "-j 4\n\t--name \"quoted\"  'single \"quoted\"'\r\nsplit\\ word \"esc\\\"aped\" ''\na");
+
+			auto jobs = 0;
+			auto name = ""s;
+			auto files = std::vector<std::string_view>{};
+			auto p = args::parser{}
+				.response_files()
+				.option("-j", &jobs)
+				.option("--name", &name)
+				.rest_bulk("FILES", [&](std::span<const std::string_view> values) {
+					files.insert(std::end(files), std::begin(values), std::end(values));
+				});
+
+			auto context = args::parse_context{};
+			auto response = "@" + path;
+			const char* argv[] = {"exec", "first", response.c_str(), "last"};
+			p.parse(context, std::size(argv), argv);
+
+			ctl::expect_equal(jobs, 4);
+			ctl::expect_equal(name, "quoted"s);
+			ctl::expect_equal(files, std::vector<std::string_view>{"first", "single \"quoted\"", "split word", "esc\"aped", "", "a", "last"});
+
+			::unlink(path.c_str());
+		});
+
+		it("expands nested response files", [=]{
+			auto root = "/tmp/args-test-response-nested-"s + std::to_string(::getpid());
+			write_file(root + ".outer", "a @" + root + ".inner d '@literal' \\@escaped");
+			write_file(root + ".inner", "b\nc");
+
+			auto files = std::vector<std::string>{};
+			auto p = args::parser{}
+				.response_files()
+				.rest("FILES", &files);
+
+			auto response = "@" + root + ".outer";
+			const char* argv[] = {"exec", response.c_str(), "--", response.c_str()};
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(files, std::vector<std::string>{"a", "b", "c", "d", "@literal", "@escaped", response});
+
+			::unlink((root + ".outer").c_str());
+			::unlink((root + ".inner").c_str());
+		});
+
+		it("reports missing and recursive response files", [=]{
+			auto root = "/tmp/args-test-response-cycle-"s + std::to_string(::getpid());
+			write_file(root + ".first", "a @" + root + ".second");
+			write_file(root + ".second", "b @" + root + ".first");
+
+			auto files = std::vector<std::string>{};
+			auto p = args::parser{}
+				.response_files()
+				.rest("FILES", &files);
+
+			auto missing = "@" + root + ".missing";
+			const char* missing_argv[] = {"exec", "x", missing.c_str()};
+			auto recursive = "@" + root + ".first";
+			const char* recursive_argv[] = {"exec", recursive.c_str()};
+
+#ifdef __cpp_lib_expected
+			auto context = args::parse_context{};
+			auto missing_result = p.try_parse(context, std::size(missing_argv), missing_argv);
+			ctl::expect_fail(missing_result.has_value());
+			ctl::expect_ok(missing_result.error().code == args::errc::invalid_response_file);
+			ctl::expect_equal(missing_result.error().token, 2);
+			ctl::expect_equal(missing_result.error().message(), "Can't read response file \"" + root + ".missing\".");
+
+			auto recursive_result = p.try_parse(context, std::size(recursive_argv), recursive_argv);
+			ctl::expect_fail(recursive_result.has_value());
+			ctl::expect_ok(recursive_result.error().code == args::errc::recursive_response_file);
+			ctl::expect_equal(recursive_result.error().message(), "Response file \"" + root + ".first\" includes itself.");
+#endif
+
+			auto catched = 0;
+			try {
+				p.parse(std::size(recursive_argv), recursive_argv);
+			} catch (const std::runtime_error& err) {
+				ctl::expect_equal(std::string{err.what()}, "Response file \"" + root + ".first\" includes itself.");
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+
+			::unlink((root + ".first").c_str());
+			::unlink((root + ".second").c_str());
+		});
+
+		it("keeps @ tokens when not enabled", []{
+			auto files = std::vector<std::string>{};
+			auto p = args::parser{}
+				.rest("FILES", &files);
+
+			const char* argv[] = {"exec", "@nonexistent"};
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(files, std::vector<std::string>{"@nonexistent"});
+		});
+	});
+#endif
+
+#ifdef ARGS_ARGUMENT_STREAMS
+	describe("NUL-delimited arguments", []{
+		it("reads rest args from a file", []{
+			auto path = "/tmp/args-test-nul-"s + std::to_string(::getpid());
+			auto content = "a\0-b\0\0c d"s;
+			auto file = std::fopen(path.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+
+			auto verbose = false;
+			auto files = std::vector<std::string>{};
+			auto p = args::parser{}
+				.nul_args("--args0-from")
+				.option("--verbose", &verbose)
+				.rest_bulk("FILES", [&](std::span<const std::string_view> values) {
+					files.insert(std::end(files), std::begin(values), std::end(values));
+				});
+
+			const char* argv[] = {"exec", "x", "--args0-from", path.c_str(), "--verbose"};
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_ok(verbose);
+			ctl::expect_equal(files, std::vector<std::string>{"x", "a", "-b", "", "c d"});
+
+			::unlink(path.c_str());
+		});
+
+		it("reads many args from stdin in chunks", []{
+			const auto count = 300000;
+			int fds[2];
+			ctl::expect_equal(::pipe(fds), 0);
+			auto saved_stdin = ::dup(STDIN_FILENO);
+			::dup2(fds[0], STDIN_FILENO);
+			::close(fds[0]);
+			auto writer = std::thread([&] {
+				auto content = ""s;
+				for (auto i = 0; i < count; i++) {
+					content += std::to_string(i);
+					content.push_back('\0');
+				}
+				for (std::size_t offset = 0; offset < content.size();) {
+					auto size = ::write(fds[1], content.data() + offset, std::min<std::size_t>(content.size() - offset, 100000));
+					offset += size > 0 ? size : 0;
+				}
+				::close(fds[1]);
+			});
+
+			auto sum = 0ll;
+			auto last = -1;
+			auto batches = 0;
+			auto values = 0;
+			auto p = args::parser{}
+				.nul_args("--args0-from");
+			p.command("sum")
+				.rest<int>("VALUES", [&](int value) {
+					sum += value;
+					last = value;
+				});
+			p.command("count")
+				.rest_bulk("VALUES", [&](std::span<const std::string_view> chunk) {
+					batches++;
+					values += chunk.size();
+				});
+
+			const char* argv[] = {"exec", "sum", "--args0-from=-"};
+			p.parse(std::size(argv), argv);
+			writer.join();
+			::dup2(saved_stdin, STDIN_FILENO);
+			::close(saved_stdin);
+
+			ctl::expect_equal(sum, static_cast<long long>(count) * (count - 1) / 2);
+			ctl::expect_equal(last, count - 1);
+
+			auto path = "/tmp/args-test-nul-bulk-"s + std::to_string(::getpid());
+			auto file = std::fopen(path.c_str(), "wb");
+			for (auto i = 0; i < 10000; i++) {
+				std::fwrite("value", 1, 6, file);
+			}
+			std::fclose(file);
+			const char* bulk[] = {"exec", "count", "--args0-from", path.c_str()};
+			p.parse(std::size(bulk), bulk);
+
+			ctl::expect_equal(values, 10000);
+			ctl::expect_ok(batches > 1);
+
+			::unlink(path.c_str());
+		});
+
+		it("reports invalid values and unreadable sources", []{
+			auto path = "/tmp/args-test-nul-invalid-"s + std::to_string(::getpid());
+			auto content = "1\0two\0"s;
+			auto file = std::fopen(path.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+
+			auto values = std::vector<int>{};
+			auto p = args::parser{}
+				.nul_args("--args0-from")
+				.rest("VALUES", &values);
+
+			const char* invalid[] = {"exec", "--args0-from", path.c_str()};
+			auto catched = 0;
+			try {
+				p.parse(std::size(invalid), invalid);
+			} catch (const args::invalid_arg_value& err) {
+				ctl::expect_equal(err.value, "two"s);
+				catched++;
+			}
+			ctl::expect_equal(catched, 1);
+
+#ifdef __cpp_lib_expected
+			auto context = args::parse_context{};
+			auto invalid_result = p.try_parse(context, std::size(invalid), invalid);
+			ctl::expect_fail(invalid_result.has_value());
+			ctl::expect_equal(invalid_result.error().token, 4);
+
+			const char* missing[] = {"exec", "--args0-from=/nonexistent/args"};
+			auto missing_result = p.try_parse(context, std::size(missing), missing);
+			ctl::expect_fail(missing_result.has_value());
+			ctl::expect_ok(missing_result.error().code == args::errc::invalid_args_stream);
+			ctl::expect_equal(missing_result.error().message(), "Can't read arguments from \"/nonexistent/args\"."s);
+
+			const char* empty[] = {"exec", "--args0-from"};
+			auto empty_result = p.try_parse(context, std::size(empty), empty);
+			ctl::expect_fail(empty_result.has_value());
+			ctl::expect_ok(empty_result.error().reason == args::value_errc::empty);
+#endif
+
+			::unlink(path.c_str());
+		});
+
+		it("lists the option in help and accepts it in repl", []{
+			auto files = std::vector<std::string>{};
+			auto p = args::parser{}
+				.nul_args("--args0-from", "Read NUL-delimited FILES from a file")
+				.rest("FILES", &files);
+			p.name("exec");
+
+			ctl::expect_equal(p.format_help(),
+				"USAGE\n"
+				"  exec [options] [<FILES...>]\n"
+				"\n"
+				"ARGUMENTS\n"
+				"      FILES             \n"
+				"\n"
+				"OPTIONS\n"
+				"      --args0-from      Read NUL-delimited FILES from a file\n"s);
+
+#ifdef __cpp_lib_expected
+			auto r = args::repl{p};
+			ctl::expect_fail(static_cast<bool>(r.update("--args0-from files a")));
+			ctl::expect_fail(static_cast<bool>(r.update("--args0-from=files")));
+			ctl::expect_ok(r.update("--args0-from").code == args::errc::invalid_option_value);
+#endif
+		});
+
+		it("doesn't run external commands for streamed args", []{
+			auto root = "/tmp/args-test-nul-external-"s + std::to_string(::getpid());
+			auto path = root + ".args";
+			auto cache = root + ".index";
+			::mkdir(root.c_str(), 0755);
+			auto script = root + "/tool-hello";
+			auto file = std::fopen(script.c_str(), "wb");
+			std::fputs("#!/bin/sh\nexit 3\n", file);
+			std::fclose(file);
+			::chmod(script.c_str(), 0755);
+			auto content = "hello\0a\0"s;
+			file = std::fopen(path.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size(), file);
+			std::fclose(file);
+			auto saved_path = std::string{std::getenv("PATH")};
+			::setenv("PATH", root.c_str(), 1);
+
+			auto p = args::parser{}
+				.nul_args("--args0-from")
+				.external_commands("tool-", cache);
+
+			auto child = ::fork();
+			if (child == 0) {
+				const char* argv[] = {"exec", "--args0-from", path.c_str(), nullptr};
+				try {
+					p.parse(3, argv);
+				} catch (const args::unexpected_arg&) {
+					::_exit(0);
+				} catch (...) {
+				}
+				::_exit(1);
+			}
+			auto status = 0;
+			::waitpid(child, &status, 0);
+			::setenv("PATH", saved_path.c_str(), 1);
+
+			ctl::expect_ok(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+			for (auto file : {script, path, cache}) {
+				::unlink(file.c_str());
+			}
+			::rmdir(root.c_str());
+		});
+	});
+#endif
+
+#ifdef ARGS_BINARY_ARRAYS
+	describe("Binary arrays", []{
+		it("copies binary arrays into vectors", []{
+			auto path = "/tmp/args-test-binary-"s + std::to_string(::getpid()) + ".u64";
+			auto ids = std::vector<std::uint64_t>{};
+			for (auto i = 0; i < 100000; i++) {
+				ids.push_back(std::uint64_t{1} << 40 | i);
+			}
+			ctl::expect_ok(args::write_binary_array(path, ids));
+
+			auto values = std::vector<std::uint64_t>{};
+			auto rest = std::vector<std::uint64_t>{};
+			auto p = args::parser{}
+				.option("--ids", &values)
+				.rest("IDS", &rest);
+
+			auto option = "--ids=@bin:" + path;
+			auto arg = "@bin:" + path;
+			const char* argv[] = {"exec", "--ids", "7", option.c_str(), "1", arg.c_str()};
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(values.size(), ids.size() + 1);
+			ctl::expect_equal(values.front(), std::uint64_t{7});
+			ctl::expect_ok(std::equal(std::begin(ids), std::end(ids), std::begin(values) + 1));
+			ctl::expect_equal(rest.size(), ids.size() + 1);
+			ctl::expect_equal(rest.back(), ids.back());
+
+			::unlink(path.c_str());
+		});
+
+		it("keeps @bin: values when response files are enabled", []{
+			auto path = "/tmp/args-test-binary-response-"s + std::to_string(::getpid()) + ".u64";
+			ctl::expect_ok(args::write_binary_array(path, std::vector<std::uint64_t>{4, 5, 6}));
+
+			auto values = std::vector<std::uint64_t>{};
+			auto rest = std::vector<std::uint64_t>{};
+			auto p = args::parser{}
+				.response_files()
+				.option("--ids", &values)
+				.rest("IDS", &rest);
+
+			auto arg = "@bin:" + path;
+			const char* argv[] = {"exec", "--ids", arg.c_str(), arg.c_str()};
+			p.parse(std::size(argv), argv);
+
+			ctl::expect_equal(values, std::vector<std::uint64_t>{4, 5, 6});
+			ctl::expect_equal(rest, std::vector<std::uint64_t>{4, 5, 6});
+
+			::unlink(path.c_str());
+		});
+
+		it("maps binary arrays into spans", []{
+			auto path = "/tmp/args-test-binary-span-"s + std::to_string(::getpid()) + ".f64";
+			ctl::expect_ok(args::write_binary_array(path, std::vector<double>{0.5, -1.25, 3}));
+
+			auto weights = args::binary_array<double>{};
+			{
+				auto p = args::parser{}
+					.option("--weights", &weights);
+				auto value = "@bin:" + path;
+				const char* argv[] = {"exec", "--weights", value.c_str()};
+				p.parse(std::size(argv), argv);
+			}
+			::unlink(path.c_str());
+
+			ctl::expect_equal(weights.values.size(), std::size_t{3});
+			ctl::expect_equal(weights.values[0], 0.5);
+			ctl::expect_equal(weights.values[1], -1.25);
+			ctl::expect_equal(weights.values[2], 3.0);
+		});
+
+		it("reports invalid binary arrays", []{
+			auto path = "/tmp/args-test-binary-invalid-"s + std::to_string(::getpid());
+			ctl::expect_ok(args::write_binary_array(path, std::vector<std::uint64_t>{1, 2, 3}));
+			auto truncated = path + ".truncated";
+			auto content = ""s;
+			ctl::expect_ok(args::detail::read_file(path, content));
+			auto file = std::fopen(truncated.c_str(), "wb");
+			std::fwrite(content.data(), 1, content.size() - 1, file);
+			std::fclose(file);
+
+			auto ids = std::vector<std::uint64_t>{};
+			auto small = std::vector<std::int32_t>{};
+			auto p = args::parser{}
+				.option("--ids", &ids)
+				.option("--small", &small);
+
+			for (auto value : {"--small=@bin:" + path, "--ids=@bin:" + truncated, "--ids=@bin:/nonexistent/ids"s}) {
+				const char* argv[] = {"exec", value.c_str()};
+				auto catched = 0;
+				try {
+					p.parse(std::size(argv), argv);
+				} catch (const args::invalid_option_value& err) {
+					auto expected = "Can't read binary array \"" + value.substr(value.find('=') + 1) + "\".";
+					ctl::expect_ok(std::string{err.what()}.ends_with(expected));
+					catched++;
+				}
+				ctl::expect_equal(catched, 1);
+			}
+			ctl::expect_ok(ids.empty());
+			ctl::expect_ok(small.empty());
+
+			::unlink(path.c_str());
+			::unlink(truncated.c_str());
+		});
+	});
+#endif
+}
@@ -0,0 +1,221 @@
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../args.h"
+
+using namespace std::literals;
+
+#include "./ctl.h"
+using namespace ctl;
+
+struct request {
+	int jobs = 0;
+	std::string name = ""s;
+	bool verbose = false;
+	std::vector<std::string> files = {};
+};
+
+const auto threads_count = 8;
+const auto parses_count = 500;
+
+args::parser create_schema() {
+	auto p = args::parser{}
+		.name("rpc")
+		.option(args::required, "-j", "--jobs", "Number of jobs", &request::jobs)
+		.option("--verbose", &request::verbose);
+
+	p.command("get", "g", "Get value")
+		.arg(args::required, "KEY", &request::name)
+		.rest("FILES", &request::files);
+
+	return p;
+}
+
+template<typename F>
+void run_threads(F work) {
+	auto threads = std::vector<std::thread>{};
+	for (auto t = 0; t < threads_count; t++) {
+		threads.emplace_back(work, t);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+int main() {
+	describe("Threads", []{
+		it("parses with one schema from many threads", []{
+			const auto schema = create_schema();
+			auto failures = std::atomic<int>{0};
+
+			run_threads([&](int t) {
+				auto context = args::parse_context{};
+				for (auto i = 0; i < parses_count; i++) {
+					auto jobs = std::to_string(t * parses_count + i);
+					const char* argv[] = {"exec", "-j", jobs.c_str(), "--no-verbose", "g", "key", "a", "b"};
+					auto values = request{.verbose = true};
+					auto result = schema.try_parse(context, values, std::size(argv), argv);
+					if (!result || values.jobs != t * parses_count + i || values.verbose || values.name != "key"
+							|| values.files.size() != 2 || context.command() != "get") {
+						failures++;
+					}
+				}
+			});
+
+			ctl::expect_equal(failures.load(), 0);
+		});
+
+		it("reports errors from many threads", []{
+			const auto schema = create_schema();
+			auto failures = std::atomic<int>{0};
+
+			run_threads([&](int t) {
+				auto context = args::parse_context{};
+				for (auto i = 0; i < parses_count; i++) {
+					const char* missing[] = {"exec", "get", "key"};
+					const char* invalid[] = {"exec", "-j", "many"};
+					auto values = request{};
+					auto missing_result = schema.try_parse(context, values, std::size(missing), missing);
+					auto invalid_result = schema.try_parse(context, values, std::size(invalid), invalid);
+					if (missing_result || missing_result.error().message() != "Option \"-j, --jobs\" is required."
+							|| invalid_result || invalid_result.error().code != args::errc::invalid_option_value) {
+						failures++;
+					}
+				}
+			});
+
+			ctl::expect_equal(failures.load(), 0);
+		});
+
+		it("parses a batch", []{
+			const auto schema = create_schema();
+			auto jobs = std::vector<std::string>{};
+			for (auto i = 0; i < parses_count * threads_count; i++) {
+				jobs.push_back(std::to_string(i));
+			}
+			auto argvs = std::vector<std::array<const char*, 5>>{};
+			for (auto& j : jobs) {
+				argvs.push_back({"exec", "-j", j.c_str(), "get", "key"});
+			}
+			auto inputs = std::vector<args::argv_view>{};
+			for (auto& argv : argvs) {
+				inputs.push_back({static_cast<int>(argv.size()), argv.data()});
+			}
+
+			auto results = std::vector<int>(inputs.size(), -1);
+			args::parse_batch<request>(schema, inputs, [&](std::size_t index, std::expected<request, args::error> result) {
+				results[index] = result ? result->jobs : -1;
+			}, threads_count);
+
+			auto failures = 0;
+			for (std::size_t i = 0; i < results.size(); i++) {
+				if (results[i] != static_cast<int>(i)) {
+					failures++;
+				}
+			}
+			ctl::expect_equal(failures, 0);
+		});
+
+		it("runs a batch of commands", []{
+			auto schema = create_schema();
+			auto keys = std::atomic<int>{0};
+			schema.command("count")
+				.arg(args::required, "KEY", &request::name)
+				.action<request>([&](request& values) {
+					keys += values.name.size();
+				});
+
+			auto argv = std::vector<const char*>{"exec"};
+			for (auto i = 0; i < parses_count; i++) {
+				argv.insert(std::end(argv), {"-j", "1", "count", "key", ";;"});
+			}
+			auto status = args::run_batch<request>(schema, static_cast<int>(argv.size()), argv.data(), threads_count);
+
+			ctl::expect_equal(status.failed, std::size_t{0});
+			ctl::expect_equal(keys.load(), parses_count * 3);
+		});
+
+		it("runs rest handlers on a pool", []{
+			auto values = std::vector<std::string>{};
+			for (auto i = 0; i < parses_count; i++) {
+				values.push_back(std::to_string(i));
+			}
+			auto sum = std::atomic<int>{0};
+			auto doubled = std::vector<int>{};
+			auto unordered = std::vector<int>{};
+			auto p = args::parser{};
+			p.command("sum")
+				.rest_parallel<int>("VALUES", [&](int value) {
+					sum += value;
+				}, threads_count);
+			p.command("double")
+				.rest_parallel<int>("VALUES", [](int value) {
+					return value * 2;
+				}, &doubled, threads_count);
+			p.command("unordered")
+				.rest_parallel<int>("VALUES", [](int value) {
+					return value;
+				}, &unordered, threads_count, args::order::unordered);
+
+			for (auto command : {"sum", "double", "unordered"}) {
+				auto argv = std::vector<const char*>{"exec", command};
+				for (auto& value : values) {
+					argv.push_back(value.c_str());
+				}
+				p.parse(static_cast<int>(argv.size()), argv.data());
+			}
+
+			ctl::expect_equal(sum.load(), parses_count * (parses_count - 1) / 2);
+			ctl::expect_equal(doubled.size(), std::size_t{parses_count});
+			ctl::expect_equal(doubled.back(), (parses_count - 1) * 2);
+			ctl::expect_equal(unordered.size(), std::size_t{parses_count});
+		});
+
+		it("builds a lazy command once from many threads", []{
+			auto built = std::atomic<int>{0};
+			auto p = create_schema();
+			p.command("put", [&](auto& c) {
+				built++;
+				c.arg(args::required, "KEY", &request::name);
+			});
+			const auto& schema = p;
+			auto failures = std::atomic<int>{0};
+
+			run_threads([&](int) {
+				auto context = args::parse_context{};
+				for (auto i = 0; i < parses_count; i++) {
+					const char* argv[] = {"exec", "-j", "1", "put", "key"};
+					auto values = request{};
+					auto result = schema.try_parse(context, values, std::size(argv), argv);
+					if (!result || values.name != "key" || context.command() != "put") {
+						failures++;
+					}
+				}
+			});
+
+			ctl::expect_equal(built.load(), 1);
+			ctl::expect_equal(failures.load(), 0);
+		});
+
+		it("formats help from many threads", []{
+			const auto schema = create_schema();
+			const auto help = schema.format_help();
+			const auto command_help = schema.format_command_help("get");
+			auto failures = std::atomic<int>{0};
+
+			run_threads([&](int) {
+				for (auto i = 0; i < parses_count / 10; i++) {
+					if (schema.format_help() != help || schema.format_command_help("get") != command_help) {
+						failures++;
+					}
+				}
+			});
+
+			ctl::expect_equal(failures.load(), 0);
+		});
+	});
+}